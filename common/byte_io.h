@@ -0,0 +1,59 @@
+#ifndef BYTE_IO_H
+#define BYTE_IO_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Append-only builder for canonical instance bytes, cache payloads and wire
+// messages. Values are written in host byte order.
+class ByteWriter {
+public:
+    template <class T>
+    void put(const T& value) {
+        static_assert(is_trivially_copyable<T>::value, "POD values only");
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class It>
+    void putRange(It begin, It end) {
+        put<long long>(distance(begin, end));
+        for (It it = begin; it != end; ++it) put(*it);
+    }
+
+    // Empties the buffer but keeps its capacity for reuse.
+    void clear() { bytes.clear(); }
+    void reserve(size_t n) { bytes.reserve(n); }
+
+    const string& str() const { return bytes; }
+    const char* data() const { return bytes.data(); }
+    size_t size() const { return bytes.size(); }
+
+private:
+    string bytes;
+};
+
+// Reads back what ByteWriter wrote; throws runtime_error on truncation.
+class ByteReader {
+public:
+    ByteReader(const char* data_in, size_t size_in) : data(data_in), size(size_in) {}
+    explicit ByteReader(const string& bytes) : ByteReader(bytes.data(), bytes.size()) {}
+
+    template <class T>
+    T get() {
+        if (pos + sizeof(T) > size) throw runtime_error("truncated message");
+        T value;
+        memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    bool done() const { return pos == size; }
+    size_t remaining() const { return size - pos; }
+
+private:
+    const char* data;
+    size_t size;
+    size_t pos = 0;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "result_cache.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char kMagic[8] = {'R', 'C', 'A', 'C', 'H', 'E', '1', '\0'};
+const char* kEntryExt = ".res";
+
+const uint64_t P1 = 0x9e3779b185ebca87ULL;
+const uint64_t P2 = 0xc2b2ae3d27d4eb4fULL;
+const uint64_t P3 = 0x165667b19e3779f9ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Two independent xxhash-style lanes in one pass over the data.
+pair<uint64_t, uint64_t> hashBytes(const string& data, uint64_t seed) {
+    uint64_t a = seed + P1, b = (seed ^ P3) + P2;
+    size_t len = data.size(), i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, data.data() + i, 8);
+        a = rotl(a + w * P2, 31) * P1;
+        b = rotl(b ^ (w * P1), 27) * P2 + P3;
+    }
+    uint64_t tail = len;
+    for (; i < len; i++) tail = (tail << 8) | (unsigned char)data[i];
+    a = rotl(a ^ (tail * P2), 31) * P1;
+    b = rotl(b + tail * P1, 27) * P2;
+    return {avalanche(a ^ len), avalanche(b + a)};
+}
+
+string toHex(uint64_t x) {
+    static const char* digits = "0123456789abcdef";
+    string s(16, '0');
+    for (int i = 15; i >= 0; i--, x >>= 4) s[i] = digits[x & 15];
+    return s;
+}
+
+}  // namespace
+
+ResultCache::ResultCache(const string& dir_in, long long max_bytes_in)
+    : dir(dir_in), max_bytes(max_bytes_in) {
+    fs::create_directories(dir);
+}
+
+string ResultCache::makeKey(const string& engine, const string& version,
+                            const string& canonical) {
+    uint64_t seed = hashBytes(engine + '\0' + version, 0).first;
+    auto [h1, h2] = hashBytes(canonical, seed);
+    return toHex(h1) + toHex(h2);
+}
+
+string ResultCache::entryPath(const string& key) const {
+    return (fs::path(dir) / (key + kEntryExt)).string();
+}
+
+bool ResultCache::lookup(const string& key, string& payload) {
+    string path = entryPath(key);
+    error_code ec;
+    uintmax_t size = fs::is_regular_file(path, ec) ? fs::file_size(path, ec) : 0;
+    ifstream in(path, ios::binary);
+    string data(ec ? 0 : size, '\0');
+    if (!in || ec || !in.read(&data[0], data.size())) {
+        misses++;
+        return false;
+    }
+    in.close();
+
+    // Header: magic, payload length, payload checksum. A damaged entry is
+    // dropped and counted as a miss.
+    size_t header = sizeof(kMagic) + 2 * sizeof(uint64_t);
+    bool valid = data.size() >= header && memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+    if (valid) {
+        uint64_t length, checksum;
+        memcpy(&length, data.data() + sizeof(kMagic), sizeof(length));
+        memcpy(&checksum, data.data() + sizeof(kMagic) + sizeof(length), sizeof(checksum));
+        payload = data.substr(header);
+        valid = payload.size() == length && hashBytes(payload, 0).first == checksum;
+    }
+
+    if (!valid) {
+        fs::remove(path, ec);
+        misses++;
+        return false;
+    }
+
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    hits++;
+    return true;
+}
+
+bool ResultCache::store(const string& key, const string& payload) {
+    static atomic<unsigned long long> counter(0);
+    unsigned long long unique = counter++ ^
+        ((unsigned long long)chrono::steady_clock::now().time_since_epoch().count() << 16) ^
+        hash<thread::id>()(this_thread::get_id());
+    string final_path = entryPath(key);
+    string tmp_path = final_path + ".tmp." + toHex(unique);
+
+    // A full disk or read-only directory must not lose a finished solve:
+    // failures are counted and the temporary file is removed.
+    error_code ec;
+    bool written;
+    {
+        ofstream out(tmp_path, ios::binary | ios::trunc);
+        uint64_t length = payload.size(), checksum = hashBytes(payload, 0).first;
+        out.write(kMagic, sizeof(kMagic));
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        out.write(payload.data(), payload.size());
+        written = (bool)out.flush();
+    }
+
+    // rename() replaces the destination atomically, so concurrent readers see
+    // either the old entry or the complete new one.
+    if (written) fs::rename(tmp_path, final_path, ec);
+    if (!written || ec) {
+        fs::remove(tmp_path, ec);
+        failed_stores++;
+        return false;
+    }
+
+    stores++;
+    evict();
+    return true;
+}
+
+void ResultCache::evict() {
+    vector<pair<fs::file_time_type, fs::path>> entries;
+    long long total = 0;
+    error_code ec;
+
+    for (const auto& item : fs::directory_iterator(dir, ec)) {
+        if (!item.is_regular_file(ec) || item.path().extension() != kEntryExt) continue;
+        long long size = item.file_size(ec);
+        if (ec) continue;
+        total += size;
+        entries.push_back({item.last_write_time(ec), item.path()});
+    }
+    if (total <= max_bytes) return;
+
+    sort(entries.begin(), entries.end());
+    for (const auto& [when, path] : entries) {
+        if (total <= max_bytes) break;
+        long long size = fs::file_size(path, ec);
+        if (ec) continue;
+        if (fs::remove(path, ec)) {
+            total -= size;
+            evictions++;
+        }
+    }
+}
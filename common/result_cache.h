@@ -0,0 +1,47 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <bits/stdc++.h>
+#include "byte_io.h"
+using namespace std;
+
+struct CacheStats {
+    long long hits;
+    long long misses;
+    long long stores;
+    long long evictions;
+    long long failed_stores;  // writes that failed (disk full, read-only dir)
+};
+
+// Content-addressed on-disk cache of solver results, shared by the reviewer
+// assignment and set cover drivers. Entries live in `dir` as one file per key;
+// writes go to a temporary file that is renamed into place, so readers never
+// see a partial entry. Hits refresh the entry's timestamp, and stores evict
+// least recently used entries once the directory exceeds `max_bytes`.
+// One instance per thread; separate processes may share a directory.
+class ResultCache {
+public:
+    explicit ResultCache(const string& dir, long long max_bytes = 256LL << 20);
+
+    // 128-bit hex key over the engine name, engine version and the canonical
+    // bytes of the instance.
+    static string makeKey(const string& engine, const string& version,
+                          const string& canonical);
+
+    bool lookup(const string& key, string& payload);
+
+    // Never throws on I/O errors; returns false if the entry was not written.
+    bool store(const string& key, const string& payload);
+
+    CacheStats stats() const { return {hits, misses, stores, evictions, failed_stores}; }
+
+private:
+    string dir;
+    long long max_bytes;
+    long long hits = 0, misses = 0, stores = 0, evictions = 0, failed_stores = 0;
+
+    string entryPath(const string& key) const;
+    void evict();
+};
+
+#endif
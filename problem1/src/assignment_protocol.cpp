@@ -0,0 +1,167 @@
+#include "assignment_protocol.h"
+#include <bits/stdc++.h>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace protocol {
+
+#ifndef _WIN32
+
+using Deadline = chrono::steady_clock::time_point;
+
+// Waits until fd is readable or the deadline passes; no deadline waits forever.
+static bool waitReadable(int fd, const Deadline* deadline) {
+    if (!deadline) return true;
+    while (true) {
+        auto left = chrono::duration_cast<chrono::milliseconds>(
+            *deadline - chrono::steady_clock::now()).count();
+        if (left <= 0) return false;
+        pollfd pfd = {fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, (int)min<long long>(left, INT_MAX));
+        if (ready < 0 && errno == EINTR) continue;
+        return ready > 0;
+    }
+}
+
+static bool readFull(int fd, char* buf, size_t len, const Deadline* deadline) {
+    while (len > 0) {
+        if (!waitReadable(fd, deadline)) return false;
+        ssize_t got = ::recv(fd, buf, len, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        buf += got;
+        len -= got;
+    }
+    return true;
+}
+
+static bool writeFull(int fd, const char* buf, size_t len, int flags) {
+    while (len > 0) {
+        ssize_t sent = ::send(fd, buf, len, flags | MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        buf += sent;
+        len -= sent;
+    }
+    return true;
+}
+
+bool readFrame(int fd, FrameHeader& header, vector<char>& payload, int timeout_ms) {
+    Deadline deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+    const Deadline* limit = timeout_ms > 0 ? &deadline : nullptr;
+
+    if (!readFull(fd, reinterpret_cast<char*>(&header), sizeof(header), limit)) return false;
+    if (header.magic != kMagic || header.length > kMaxPayload) return false;
+
+    // Doubling from 64 KB keeps the buffer within twice the bytes received.
+    payload.clear();
+    while (payload.size() < header.length) {
+        size_t have = payload.size();
+        size_t next = min<size_t>(header.length, max<size_t>(2 * have, 64 << 10));
+        payload.resize(next);
+        if (!readFull(fd, payload.data() + have, next - have, limit)) return false;
+    }
+    return true;
+}
+
+bool writeFrame(int fd, MessageType type, uint32_t session,
+                const char* payload, size_t length) {
+    if (length > kMaxPayload) return false;
+    FrameHeader header = {kMagic, (uint32_t)type, session, (uint32_t)length};
+#ifdef MSG_MORE
+    int more = length > 0 ? MSG_MORE : 0;
+#else
+    int more = 0;
+#endif
+    return writeFull(fd, reinterpret_cast<const char*>(&header), sizeof(header), more) &&
+           writeFull(fd, payload, length, 0);
+}
+
+static sockaddr_un socketAddress(const string& path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        throw invalid_argument("socket path too long: " + path);
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+int listenUnixSocket(const string& path, int backlog) {
+    sockaddr_un addr = socketAddress(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw runtime_error("socket: " + string(strerror(errno)));
+
+    // A socket file left by a previous run would make bind() fail.
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, backlog) < 0) {
+        string err = strerror(errno);
+        ::close(fd);
+        throw runtime_error("cannot listen on " + path + ": " + err);
+    }
+    return fd;
+}
+
+int connectUnixSocket(const string& path) {
+    sockaddr_un addr = socketAddress(path);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw runtime_error("socket: " + string(strerror(errno)));
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        string err = strerror(errno);
+        ::close(fd);
+        throw runtime_error("cannot connect to " + path + ": " + err);
+    }
+    return fd;
+}
+
+int acceptConnection(int listen_fd, int timeout_ms) {
+    int fd;
+    do {
+        fd = ::accept(listen_fd, nullptr, nullptr);
+    } while (fd < 0 && errno == EINTR);
+
+    if (fd >= 0 && timeout_ms > 0) {
+        timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+    return fd;
+}
+
+void closeSocket(int fd) {
+    ::close(fd);
+}
+
+#else
+
+bool readFrame(int, FrameHeader&, vector<char>&, int) {
+    throw runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+bool writeFrame(int, MessageType, uint32_t, const char*, size_t) {
+    throw runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+int listenUnixSocket(const string&, int) {
+    throw runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+int connectUnixSocket(const string&) {
+    throw runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+int acceptConnection(int, int) {
+    return -1;
+}
+
+void closeSocket(int) {}
+
+#endif
+
+} // namespace protocol
@@ -0,0 +1,81 @@
+#ifndef ASSIGNMENT_PROTOCOL_H
+#define ASSIGNMENT_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wire protocol of the assignment service. Every message is a 16-byte
+// FrameHeader followed by `length` payload bytes; integers are in host byte
+// order since client and server share a machine. Payloads (int32 unless
+// noted):
+//
+//   SolveInstance    m, n, k[m], c[n], E (int64), E x (paper, reviewer, cost)
+//                    Replaces the session's instance and solves it.
+//   SolveDelta       D (int64), D x (op, a, b, value) applied to the session's
+//                    instance, then solves it. Ops: SetDemand(paper, -, d),
+//                    SetCapacity(reviewer, -, c), SetEdge(paper, reviewer,
+//                    cost) adds or re-costs an edge, RemoveEdge(paper,
+//                    reviewer, -).
+//   CloseSession     empty; drops the session's state. No reply.
+//
+// A solve is answered by AssignmentChunk frames, each holding count (int64)
+// and count x (paper, reviewer), followed by one Done frame with feasible,
+// cost, assigned (int64), solve_us (int64). A bad request gets a single Error
+// frame whose payload is the message text; the connection stays usable.
+//
+// The solver works in int32, so edge costs are limited to kMaxCost and an
+// instance is rejected unless total demand x largest cost, and the longest
+// possible path (papers + reviewers + 2 arcs) x largest cost x 8, fit in it.
+namespace protocol {
+
+const uint32_t kMagic = 0x31534152; // "RAS1"
+const uint32_t kMaxPayload = 64u << 20; // about 5M edges per instance
+const int kMaxCost = 1000000;
+const int kChunkPairs = 4096;
+
+enum class MessageType : uint32_t {
+    SolveInstance = 1,
+    SolveDelta = 2,
+    CloseSession = 3,
+    AssignmentChunk = 0x81,
+    Done = 0x82,
+    Error = 0x83,
+};
+
+enum class DeltaOp : int32_t {
+    SetDemand = 1,
+    SetCapacity = 2,
+    SetEdge = 3,
+    RemoveEdge = 4,
+};
+
+struct FrameHeader {
+    uint32_t magic;
+    uint32_t type;
+    uint32_t session;
+    uint32_t length;
+};
+
+// Blocking socket I/O. All return false once the peer has gone away.
+// With timeout_ms > 0, readFrame also gives up unless the whole frame arrives
+// within that time. The payload buffer grows only as bytes arrive, so a bare
+// header cannot claim kMaxPayload of memory.
+bool readFrame(int fd, FrameHeader& header, std::vector<char>& payload,
+               int timeout_ms = 0);
+bool writeFrame(int fd, MessageType type, uint32_t session,
+                const char* payload, size_t length);
+
+int listenUnixSocket(const std::string& path, int backlog);
+int connectUnixSocket(const std::string& path);
+
+// Returns -1 if no connection could be accepted. With timeout_ms > 0, writes
+// on the connection fail after stalling that long, so a peer that stops
+// reading cannot hold a worker forever.
+int acceptConnection(int listen_fd, int timeout_ms);
+void closeSocket(int fd);
+
+} // namespace protocol
+
+#endif // ASSIGNMENT_PROTOCOL_H
@@ -0,0 +1,429 @@
+#include "assignment_service.h"
+#include "assignment_protocol.h"
+#include "reviewer_assignment.h"
+#include "mcmf.h"
+#include "byte_io.h"
+#include <bits/stdc++.h>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace protocol;
+
+struct Session {
+    mutex lock;
+    ReviewerAssignment instance{0, 0};
+    unordered_map<long long, int> edgeIndex; // paper * n + reviewer -> feasibleEdges slot
+    MinCostMaxFlow network{0};
+    uint64_t last_used = 0;
+};
+
+struct WorkerBuffers {
+    vector<char> request;
+    ByteWriter reply;
+    vector<array<int, 4>> ops;
+};
+
+static long long edgeKey(const ReviewerAssignment& ra, int p, int r) {
+    return (long long)p * ra.n + r;
+}
+
+static void checkIndex(int value, int limit, const char* what) {
+    if (value < 0 || value >= limit)
+        throw invalid_argument(string(what) + " index out of range");
+}
+
+static void checkNonNegative(int value, const char* what) {
+    if (value < 0) throw invalid_argument(string(what) + " must be non-negative");
+}
+
+static void checkCost(int value) {
+    if (value < 0 || value > kMaxCost)
+        throw invalid_argument("cost must be in 0.." + to_string(kMaxCost));
+}
+
+// MinCostMaxFlow keeps flow costs, distances and potentials in int. The total
+// cost is at most total demand x largest cost, and distances are bounded by a
+// small multiple of a simple path's cost, which crosses at most m + n + 2 arcs.
+static void checkCostRange(long long total_demand, long long max_cost, int m, int n) {
+    if (total_demand > INT_MAX || total_demand * max_cost > INT_MAX)
+        throw invalid_argument("total demand x largest cost exceeds the solver's range");
+    if (max_cost * ((long long)m + n + 2) > INT_MAX / 8)
+        throw invalid_argument("largest cost too high for the instance size");
+}
+
+// Parses a full instance into `session`, replacing its previous one but
+// keeping the flow network's storage. Counts are checked against the bytes
+// actually received before anything is sized from them.
+static void loadInstance(Session& session, ByteReader& in) {
+    int m = in.get<int>();
+    int n = in.get<int>();
+    checkNonNegative(m, "paper count");
+    checkNonNegative(n, "reviewer count");
+    if (((long long)m + n) * sizeof(int) + sizeof(long long) > in.remaining())
+        throw invalid_argument("instance larger than its payload");
+
+    ReviewerAssignment ra(m, n);
+    long long total_demand = 0;
+    for (int p = 0; p < m; p++) {
+        int demand = in.get<int>();
+        checkNonNegative(demand, "demand");
+        ra.addPaperDemand(p, demand);
+        total_demand += demand;
+    }
+    for (int r = 0; r < n; r++) {
+        int cap = in.get<int>();
+        checkNonNegative(cap, "capacity");
+        ra.addReviewerCapacity(r, cap);
+    }
+
+    long long count = in.get<long long>();
+    if (count < 0 || count > (long long)m * n) throw invalid_argument("bad edge count");
+    if ((unsigned long long)count * 3 * sizeof(int) > in.remaining())
+        throw invalid_argument("instance larger than its payload");
+    unordered_map<long long, int> index;
+    index.reserve(count);
+    ra.feasibleEdges.reserve(count);
+    int max_cost = 0;
+    for (long long i = 0; i < count; i++) {
+        int p = in.get<int>(), r = in.get<int>(), w = in.get<int>();
+        checkIndex(p, m, "paper");
+        checkIndex(r, n, "reviewer");
+        checkCost(w);
+        if (!index.emplace(edgeKey(ra, p, r), (int)i).second)
+            throw invalid_argument("duplicate edge");
+        ra.addFeasibleEdge(p, r, w);
+        max_cost = max(max_cost, w);
+    }
+    if (!in.done()) throw invalid_argument("trailing bytes in instance");
+    checkCostRange(total_demand, max_cost, m, n);
+
+    session.instance = move(ra);
+    session.edgeIndex = move(index);
+}
+
+// Validates every op, and the demands and costs the instance would end up
+// with, before applying any, so a rejected delta leaves the session unchanged.
+static void applyDelta(Session& session, ByteReader& in, vector<array<int, 4>>& ops) {
+    ReviewerAssignment& ra = session.instance;
+    long long count = in.get<long long>();
+    if (count < 0) throw invalid_argument("bad delta count");
+    if ((unsigned long long)count * 4 * sizeof(int) > in.remaining())
+        throw invalid_argument("delta larger than its payload");
+
+    ops.clear();
+    for (long long i = 0; i < count; i++) {
+        array<int, 4> op = {in.get<int>(), in.get<int>(), in.get<int>(), in.get<int>()};
+        switch ((DeltaOp)op[0]) {
+        case DeltaOp::SetDemand:
+            checkIndex(op[1], ra.m, "paper");
+            checkNonNegative(op[3], "demand");
+            break;
+        case DeltaOp::SetCapacity:
+            checkIndex(op[1], ra.n, "reviewer");
+            checkNonNegative(op[3], "capacity");
+            break;
+        case DeltaOp::SetEdge:
+            checkCost(op[3]);
+            [[fallthrough]];
+        case DeltaOp::RemoveEdge:
+            checkIndex(op[1], ra.m, "paper");
+            checkIndex(op[2], ra.n, "reviewer");
+            break;
+        default:
+            throw invalid_argument("unknown delta op");
+        }
+        ops.push_back(op);
+    }
+    if (!in.done()) throw invalid_argument("trailing bytes in delta");
+
+    // Final demand of each touched paper and final cost of each touched edge
+    // (-1 once removed); later ops on the same key win.
+    unordered_map<int, int> demands;
+    unordered_map<long long, int> costs;
+    for (auto &[code, a, b, value] : ops) {
+        if ((DeltaOp)code == DeltaOp::SetDemand) demands[a] = value;
+        else if ((DeltaOp)code == DeltaOp::SetEdge) costs[edgeKey(ra, a, b)] = value;
+        else if ((DeltaOp)code == DeltaOp::RemoveEdge) costs[edgeKey(ra, a, b)] = -1;
+    }
+    long long total_demand = accumulate(ra.k.begin(), ra.k.end(), 0LL);
+    for (auto &[p, demand] : demands) total_demand += demand - ra.k[p];
+    int max_cost = 0;
+    for (auto &[p, r, w] : ra.feasibleEdges)
+        if (!costs.count(edgeKey(ra, p, r))) max_cost = max(max_cost, w);
+    for (auto &[key, w] : costs) max_cost = max(max_cost, w);
+    checkCostRange(total_demand, max_cost, ra.m, ra.n);
+
+    for (auto &[code, a, b, value] : ops) {
+        DeltaOp op = (DeltaOp)code;
+        if (op == DeltaOp::SetDemand) {
+            ra.addPaperDemand(a, value);
+        } else if (op == DeltaOp::SetCapacity) {
+            ra.addReviewerCapacity(a, value);
+        } else {
+            long long key = edgeKey(ra, a, b);
+            auto it = session.edgeIndex.find(key);
+            if (op == DeltaOp::SetEdge) {
+                if (it != session.edgeIndex.end()) {
+                    get<2>(ra.feasibleEdges[it->second]) = value;
+                } else {
+                    session.edgeIndex[key] = ra.feasibleEdges.size();
+                    ra.addFeasibleEdge(a, b, value);
+                }
+            } else if (it != session.edgeIndex.end()) {
+                // Move the last edge into the freed slot.
+                int slot = it->second;
+                session.edgeIndex.erase(it);
+                if (slot != (int)ra.feasibleEdges.size() - 1) {
+                    ra.feasibleEdges[slot] = ra.feasibleEdges.back();
+                    auto &[p, r, w] = ra.feasibleEdges[slot];
+                    session.edgeIndex[edgeKey(ra, p, r)] = slot;
+                }
+                ra.feasibleEdges.pop_back();
+            }
+        }
+    }
+}
+
+AssignmentService::AssignmentService(const ServiceOptions& opts)
+    : options(opts), listen_fd(listenUnixSocket(opts.socket_path, 128)) {
+#ifndef _WIN32
+    if (::pipe(wake_fd) < 0) {
+        closeSocket(listen_fd);
+        throw runtime_error("pipe: " + string(strerror(errno)));
+    }
+#endif
+}
+
+AssignmentService::~AssignmentService() {
+#ifndef _WIN32
+    ::close(wake_fd[0]);
+    ::close(wake_fd[1]);
+#endif
+    closeSocket(listen_fd);
+    remove(options.socket_path.c_str());
+}
+
+void AssignmentService::wake() {
+#ifndef _WIN32
+    char byte = 1;
+    ssize_t written = ::write(wake_fd[1], &byte, 1);
+    (void)written; // a full pipe already guarantees a wakeup
+#endif
+}
+
+void AssignmentService::stop() {
+    stopping.store(true);
+    wake();
+}
+
+ServiceStats AssignmentService::stats() const {
+    return {n_connections.load(), n_requests.load(), n_errors.load(), n_evicted.load()};
+}
+
+#ifndef _WIN32
+
+void AssignmentService::run() {
+    int hw = max(1u, thread::hardware_concurrency());
+    int n_workers = options.n_workers > 0 ? options.n_workers : hw;
+    // Concurrent solves split the cores instead of each starting a
+    // full-width shortest-path pool.
+    kernel_threads = max(1, hw / n_workers);
+    vector<thread> workers;
+    for (int i = 0; i < n_workers; i++)
+        workers.emplace_back([this] { workerLoop(); });
+
+    vector<int> idle;
+    vector<pollfd> fds;
+    while (!stopping.load()) {
+        fds.clear();
+        fds.push_back({wake_fd[0], POLLIN, 0});
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (int fd : idle) fds.push_back({fd, POLLIN, 0});
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Readable connections (or hung-up ones, which the worker closes)
+        // leave the idle set until their worker hands them back.
+        idle.clear();
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            for (size_t i = 2; i < fds.size(); i++) {
+                if (fds[i].revents) ready.push_back(fds[i].fd);
+                else idle.push_back(fds[i].fd);
+            }
+        }
+        queue_cv.notify_all();
+
+        if (fds[0].revents) {
+            // Bytes left in the pipe just cause another wakeup.
+            char drain[64];
+            ssize_t got = ::read(wake_fd[0], drain, sizeof(drain));
+            (void)got;
+            lock_guard<mutex> lock(queue_mutex);
+            idle.insert(idle.end(), returned.begin(), returned.end());
+            returned.clear();
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int fd = acceptConnection(listen_fd, options.io_timeout_ms);
+            if (fd >= 0) {
+                n_connections++;
+                idle.push_back(fd);
+            }
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        stopping.store(true);
+    }
+    queue_cv.notify_all();
+    for (auto &w : workers) w.join();
+
+    for (int fd : idle) closeSocket(fd);
+    for (int fd : ready) closeSocket(fd);
+    for (int fd : returned) closeSocket(fd);
+    ready.clear();
+    returned.clear();
+}
+
+#else
+
+void AssignmentService::run() {
+    throw runtime_error("Unix domain sockets are not supported on this platform");
+}
+
+#endif
+
+// Buffers above this after a request are released, so one large instance
+// does not pin its memory to the worker.
+static const size_t kKeptBufferBytes = 1 << 20;
+
+void AssignmentService::workerLoop() {
+    WorkerBuffers buffers;
+    buffers.request.reserve(kKeptBufferBytes);
+    buffers.reply.reserve(kChunkPairs * 2 * sizeof(int) + sizeof(long long));
+
+    while (true) {
+        int fd;
+        {
+            unique_lock<mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [&] { return stopping.load() || !ready.empty(); });
+            if (stopping.load()) return;
+            fd = ready.front();
+            ready.pop_front();
+        }
+
+        bool keep = serveRequest(fd, buffers);
+        if (buffers.request.capacity() > kKeptBufferBytes) {
+            vector<char>().swap(buffers.request);
+            buffers.request.reserve(kKeptBufferBytes);
+        }
+        if (buffers.ops.capacity() * sizeof(buffers.ops[0]) > kKeptBufferBytes)
+            vector<array<int, 4>>().swap(buffers.ops);
+        if (!keep) {
+            closeSocket(fd);
+            continue;
+        }
+
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            returned.push_back(fd);
+        }
+        wake();
+    }
+}
+
+// Reads and answers one request; false once the connection should close.
+bool AssignmentService::serveRequest(int fd, WorkerBuffers& buffers) {
+    FrameHeader header;
+    if (!readFrame(fd, header, buffers.request, options.io_timeout_ms)) return false;
+    n_requests++;
+
+    MessageType type = (MessageType)header.type;
+    if (type == MessageType::CloseSession) {
+        dropSession(header.session);
+        return true;
+    }
+    if (type == MessageType::SolveInstance || type == MessageType::SolveDelta)
+        return handleSolve(fd, header.session, type == MessageType::SolveDelta, buffers);
+
+    n_errors++;
+    string msg = "unknown message type";
+    return writeFrame(fd, MessageType::Error, header.session, msg.data(), msg.size());
+}
+
+bool AssignmentService::handleSolve(int fd, uint32_t session_id, bool is_delta,
+                                    WorkerBuffers& buffers) {
+    AssignmentResult result;
+    try {
+        shared_ptr<Session> session = findSession(session_id, !is_delta);
+        if (!session) throw invalid_argument("unknown session");
+
+        lock_guard<mutex> lock(session->lock);
+        ByteReader in(buffers.request.data(), buffers.request.size());
+        if (is_delta) applyDelta(*session, in, buffers.ops);
+        else loadInstance(*session, in);
+        session->network.nThreads = kernel_threads;
+        result = session->instance.computeAssignment(session->network);
+    } catch (const exception& e) {
+        n_errors++;
+        string msg = e.what();
+        return writeFrame(fd, MessageType::Error, session_id, msg.data(), msg.size());
+    }
+
+    ByteWriter& out = buffers.reply;
+    size_t total = result.assignments.size();
+    for (size_t begin = 0; begin < total; begin += kChunkPairs) {
+        size_t end = min(total, begin + kChunkPairs);
+        out.clear();
+        out.put<long long>(end - begin);
+        for (size_t i = begin; i < end; i++) {
+            out.put(result.assignments[i].first);
+            out.put(result.assignments[i].second);
+        }
+        if (!writeFrame(fd, MessageType::AssignmentChunk, session_id, out.data(), out.size()))
+            return false;
+    }
+
+    out.clear();
+    out.put<int>(result.feasible);
+    out.put<int>(result.cost);
+    out.put<long long>(total);
+    out.put<long long>(llround(result.solve_ms * 1000));
+    return writeFrame(fd, MessageType::Done, session_id, out.data(), out.size());
+}
+
+shared_ptr<Session> AssignmentService::findSession(uint32_t id, bool create) {
+    lock_guard<mutex> lock(sessions_mutex);
+    auto it = sessions.find(id);
+    if (it != sessions.end()) {
+        it->second->last_used = ++session_clock;
+        return it->second;
+    }
+    if (!create) return nullptr;
+
+    if ((int)sessions.size() >= max(1, options.max_sessions)) {
+        auto oldest = min_element(sessions.begin(), sessions.end(),
+            [](const auto& a, const auto& b) { return a.second->last_used < b.second->last_used; });
+        sessions.erase(oldest);
+        n_evicted++;
+    }
+
+    auto session = make_shared<Session>();
+    session->last_used = ++session_clock;
+    sessions[id] = session;
+    return session;
+}
+
+void AssignmentService::dropSession(uint32_t id) {
+    lock_guard<mutex> lock(sessions_mutex);
+    sessions.erase(id);
+}
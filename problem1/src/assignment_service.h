@@ -0,0 +1,79 @@
+#ifndef ASSIGNMENT_SERVICE_H
+#define ASSIGNMENT_SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ServiceOptions {
+    std::string socket_path;
+    int n_workers = 0;        // 0 = all hardware threads
+    int max_sessions = 1024;  // least recently used sessions are dropped beyond this
+    int io_timeout_ms = 10000; // a request not fully received within this closes its connection
+};
+
+struct ServiceStats {
+    long long connections;
+    long long requests;
+    long long errors;
+    long long sessions_evicted;
+};
+
+struct Session;
+struct WorkerBuffers;
+
+// Long-running reviewer assignment server on a Unix domain socket, speaking
+// the protocol in assignment_protocol.h. Each session id keeps its instance
+// and flow network between requests, so deltas re-solve without rebuilding
+// allocations. A poll loop watches idle connections and hands each incoming
+// request to a fixed worker pool, so clients share workers request by request
+// rather than holding one for their whole connection. Workers own
+// preallocated request and reply buffers; requests on one session are
+// serialized, requests on different sessions run concurrently.
+class AssignmentService {
+public:
+    // Starts listening immediately; clients may connect before run().
+    explicit AssignmentService(const ServiceOptions& opts);
+    ~AssignmentService();
+
+    // Serves until stop(); returns once every worker has exited.
+    void run();
+
+    // Safe to call from a signal handler or any thread.
+    void stop();
+
+    ServiceStats stats() const;
+
+private:
+    ServiceOptions options;
+    int listen_fd;
+    int wake_fd[2];               // workers and stop() wake the poll loop
+    std::atomic<bool> stopping{false};
+    int kernel_threads = 1;       // shortest-path threads per solve: cores / workers
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::deque<int> ready;        // connections with a request waiting
+    std::vector<int> returned;    // connections handed back by workers
+
+    std::mutex sessions_mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<Session>> sessions;
+    uint64_t session_clock = 0;
+
+    std::atomic<long long> n_connections{0}, n_requests{0}, n_errors{0}, n_evicted{0};
+
+    void workerLoop();
+    void wake();
+    bool serveRequest(int fd, WorkerBuffers& buffers);
+    bool handleSolve(int fd, uint32_t session_id, bool is_delta, WorkerBuffers& buffers);
+    std::shared_ptr<Session> findSession(uint32_t id, bool create);
+    void dropSession(uint32_t id);
+};
+
+#endif // ASSIGNMENT_SERVICE_H
@@ -0,0 +1,161 @@
+#include "delta_stepping.h"
+#include "mcmf.h"
+using namespace std;
+
+// Vertices one worker claims at a time; reviewer-graph vertices carry
+// hundreds of arcs each, so small chunks still amortize the shared counter.
+static const size_t kGrain = 16;
+
+DeltaStepping::DeltaStepping(int n_threads_in)
+    : n_threads(max(1, n_threads_in)), local(n_threads) {
+    for (int tid = 1; tid < n_threads; tid++)
+        pool.emplace_back([this, tid] { workerLoop(tid); });
+}
+
+DeltaStepping::~DeltaStepping() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        quitting = true;
+    }
+    start_cv.notify_all();
+    for (auto &t : pool) t.join();
+}
+
+void DeltaStepping::workerLoop(int tid) {
+    long long seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            start_cv.wait(lock, [&] { return quitting || generation != seen; });
+            if (quitting) return;
+            seen = generation;
+        }
+        relax(tid);
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            if (--running == 0) done_cv.notify_one();
+        }
+    }
+}
+
+// The mutex hand-off orders each round after the previous merge and before
+// the next one, so only the distance updates inside a round need atomics.
+void DeltaStepping::runRound() {
+    next_index.store(0, memory_order_relaxed);
+    if (pool.empty() || frontier.size() <= kGrain) {
+        relax(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        generation++;
+        running = (int)pool.size();
+    }
+    start_cv.notify_all();
+    relax(0);
+    unique_lock<mutex> lock(pool_mutex);
+    done_cv.wait(lock, [&] { return running == 0; });
+}
+
+void DeltaStepping::relax(int tid) {
+    const vector<vector<Edge>>& G = *graph;
+    const vector<int>& potential = *potentials;
+    WorkerBuckets& out = local[tid];
+
+    for (size_t begin; (begin = next_index.fetch_add(kGrain, memory_order_relaxed)) < frontier.size();) {
+        size_t end = min(frontier.size(), begin + kGrain);
+        for (size_t k = begin; k < end; k++) {
+            int u = frontier[k];
+            int du = best[u].load(memory_order_relaxed);
+            // Frontier entries are unique, so settled[u] has a single writer.
+            if (settled[u] == du) continue;
+            settled[u] = du;
+
+            for (const Edge &e : G[u]) {
+                if (e.cap <= 0) continue;
+                int nd = du + e.cost + potential[u] - potential[e.to];
+                int old = best[e.to].load(memory_order_relaxed);
+                while (nd < old &&
+                       !best[e.to].compare_exchange_weak(old, nd, memory_order_relaxed)) {}
+                if (nd >= old) continue;
+
+                int b = nd < 0 ? current : max(current, nd / bucket_width);
+                if (b >= (int)out.buckets.size()) out.buckets.resize(b + 1);
+                if (out.buckets[b].empty()) out.touched.push_back(b);
+                out.buckets[b].push_back(e.to);
+            }
+        }
+    }
+}
+
+// Vertices improved into the current bucket form the next frontier; the
+// rest wait in the shared buckets.
+void DeltaStepping::mergeRound() {
+    round++;
+    frontier.clear();
+    for (WorkerBuckets &w : local) {
+        for (int b : w.touched) {
+            vector<int>& src = w.buckets[b];
+            if (b == current) {
+                for (int v : src)
+                    if (mark[v] != round) {
+                        mark[v] = round;
+                        frontier.push_back(v);
+                    }
+            } else {
+                if (b >= (int)buckets.size()) buckets.resize(b + 1);
+                buckets[b].insert(buckets[b].end(), src.begin(), src.end());
+            }
+            src.clear();
+        }
+        w.touched.clear();
+    }
+}
+
+void DeltaStepping::takeFrontier(vector<int>& pending) {
+    round++;
+    frontier.clear();
+    for (int v : pending)
+        if (mark[v] != round) {
+            mark[v] = round;
+            frontier.push_back(v);
+        }
+    pending.clear();
+}
+
+void DeltaStepping::run(const vector<vector<Edge>>& G, const vector<int>& potential,
+                        int s, int width, vector<int>& dist) {
+    if (width <= 0) throw invalid_argument("bucket width must be positive");
+
+    size_t n = G.size();
+    if (best_size < n) {
+        best = make_unique<atomic<int>[]>(n);
+        best_size = n;
+    }
+    for (size_t v = 0; v < n; v++) best[v].store(INT_MAX, memory_order_relaxed);
+    best[s].store(0, memory_order_relaxed);
+    settled.assign(n, INT_MAX);
+    mark.assign(n, 0);
+    round = 0;
+    for (auto &b : buckets) b.clear();
+
+    graph = &G;
+    potentials = &potential;
+    bucket_width = width;
+    current = 0;
+    frontier.assign(1, s);
+
+    while (true) {
+        while (!frontier.empty()) {
+            runRound();
+            mergeRound();
+        }
+        while (++current < (int)buckets.size() && buckets[current].empty()) {}
+        if (current >= (int)buckets.size()) break;
+        takeFrontier(buckets[current]);
+    }
+
+    dist.resize(n);
+    for (size_t v = 0; v < n; v++) dist[v] = best[v].load(memory_order_relaxed);
+}
@@ -0,0 +1,69 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+struct Edge;
+
+// Parallel delta-stepping shortest paths for the phases of MinCostMaxFlow.
+// Arc weights are the reduced costs cost + potential[u] - potential[v] of
+// residual arcs (cap > 0). The result is the exact shortest distance of every
+// vertex, so it matches the Dijkstra kernel value for value; a vertex whose
+// distance drops below the current bucket is requeued into it, which handles
+// the occasional negative reduced cost the same way lazy-deletion Dijkstra
+// does.
+//
+// Each round relaxes the current bucket's frontier across the worker pool:
+// distances are lowered with relaxed atomic compare-and-swap, and improved
+// vertices go into the worker's own bucket buffers, which are merged once the
+// round ends. Workers and buffers persist across the runs of one solve.
+class DeltaStepping {
+public:
+    explicit DeltaStepping(int n_threads);
+    ~DeltaStepping();
+
+    int threads() const { return n_threads; }
+
+    // Fills dist (resized to G.size()) with distances from s; unreachable
+    // vertices get INT_MAX. width is the bucket width and must be positive.
+    void run(const vector<vector<Edge>>& G, const vector<int>& potential,
+             int s, int width, vector<int>& dist);
+
+private:
+    struct WorkerBuckets {
+        vector<vector<int>> buckets;  // indexed by absolute bucket number
+        vector<int> touched;          // buckets made non-empty this round
+    };
+
+    int n_threads;
+    vector<thread> pool;
+    mutex pool_mutex;
+    condition_variable start_cv, done_cv;
+    long long generation = 0;
+    int running = 0;
+    bool quitting = false;
+
+    // State of the current run, read by every worker during a round.
+    const vector<vector<Edge>>* graph = nullptr;
+    const vector<int>* potentials = nullptr;
+    unique_ptr<atomic<int>[]> best;
+    size_t best_size = 0;
+    vector<int> settled;              // distance each vertex was last relaxed at
+    vector<int> frontier;
+    atomic<size_t> next_index{0};
+    int current = 0, bucket_width = 1;
+
+    vector<vector<int>> buckets;      // pending vertices of later buckets
+    vector<int> mark;                 // frontier dedup, stamped with `round`
+    int round = 0;
+    vector<WorkerBuckets> local;
+
+    void workerLoop(int tid);
+    void runRound();
+    void relax(int tid);
+    void mergeRound();
+    void takeFrontier(vector<int>& pending);
+};
+
+#endif // DELTA_STEPPING_H
@@ -1,48 +1,86 @@
 #include <bits/stdc++.h>
 #include "mcmf.h"
 #include "reviewer_assignment.h"
+#include "result_cache.h"
+#include "assignment_service.h"
 using namespace std;
 
 struct Experiment {
     int m, n;
 
-    pair<bool, double> run() {
-        vector<int> k(m, 3);
-        vector<int> c(n, (m * 3) / n + 2);
-
-        int S = 0;
-        int paperStart = 1;
-        int reviewerStart = paperStart + m;
-        int T = reviewerStart + n;
-        int N = T + 1;
-
-        MinCostMaxFlow mcmf(N);
+    pair<bool, double> run(ResultCache* cache) {
+        ReviewerAssignment ra(m, n);
 
         for (int p = 0; p < m; p++)
-            mcmf.addEdge(S, paperStart + p, k[p], 0);
+            ra.addPaperDemand(p, 3);
+        for (int r = 0; r < n; r++)
+            ra.addReviewerCapacity(r, (m * 3) / n + 2);
 
         mt19937 rng(42);
         uniform_int_distribution<int> costDist(1, 10);
 
         for (int p = 0; p < m; p++)
             for (int r = 0; r < n; r++)
-                mcmf.addEdge(paperStart + p, reviewerStart + r, 1, costDist(rng));
+                ra.addFeasibleEdge(p, r, costDist(rng));
 
-        for (int r = 0; r < n; r++)
-            mcmf.addEdge(reviewerStart + r, T, c[r], 0);
+        // With a cache, a hit reports the runtime measured when it was stored.
+        ra.setResultCache(cache);
+        AssignmentResult result = ra.computeAssignment();
+        return {result.feasible, result.solve_ms};
+    }
+};
 
-        int K = accumulate(k.begin(), k.end(), 0);
+static AssignmentService* g_service = nullptr;
 
-        auto start = chrono::high_resolution_clock::now();
-        auto [flow, cost] = mcmf.minCostMaxFlow(S, T, K);
-        auto end = chrono::high_resolution_clock::now();
+static void stopService(int) {
+    if (g_service) g_service->stop();
+}
+
+// Daemon mode: serves assignment requests until SIGINT/SIGTERM.
+int serve(const ServiceOptions& opts) {
+    AssignmentService service(opts);
+    g_service = &service;
+    signal(SIGINT, stopService);
+    signal(SIGTERM, stopService);
+
+    cerr << "listening on " << opts.socket_path << "\n";
+    service.run();
+    g_service = nullptr;
+
+    ServiceStats s = service.stats();
+    cerr << "served " << s.requests << " requests on " << s.connections
+         << " connections, " << s.errors << " errors, "
+         << s.sessions_evicted << " sessions evicted\n";
+    return 0;
+}
 
-        double ms = chrono::duration<double, milli>(end - start).count();
-        return {flow == K, ms};
+// Usage: reviewer_experiments [--cache dir]
+//        reviewer_experiments --serve socket [--workers n] [--max-sessions n]
+//                             [--io-timeout ms]
+int main(int argc, char** argv) {
+    unique_ptr<ResultCache> cache;
+    ServiceOptions service;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string flag = argv[i];
+            if (i + 1 >= argc) throw invalid_argument("missing value for " + flag);
+            string value = argv[++i];
+
+            if (flag == "--cache") cache = make_unique<ResultCache>(value);
+            else if (flag == "--serve") service.socket_path = value;
+            else if (flag == "--workers") service.n_workers = stoi(value);
+            else if (flag == "--max-sessions") service.max_sessions = stoi(value);
+            else if (flag == "--io-timeout") service.io_timeout_ms = stoi(value);
+            else throw invalid_argument("unknown flag " + flag);
+        }
+
+        if (!service.socket_path.empty()) return serve(service);
+    } catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
     }
-};
 
-int main() {
     vector<int> paperSizes = {10, 20, 50, 100, 150, 200, 300};
     vector<int> reviewerSizes = {6, 10, 20, 30, 40, 60, 80};
 
@@ -53,8 +91,15 @@ int main() {
         int n = reviewerSizes[idx];
 
         Experiment ex{m, n};
-        auto [ok, ms] = ex.run();
+        auto [ok, ms] = ex.run(cache.get());
 
         cout << m << "," << n << "," << ms << "," << ok << "\n";
     }
+
+    if (cache) {
+        CacheStats s = cache->stats();
+        cerr << "cache: " << s.hits << " hits, " << s.misses << " misses, "
+             << s.stores << " stores, " << s.evictions << " evictions, "
+             << s.failed_stores << " failed stores\n";
+    }
 }
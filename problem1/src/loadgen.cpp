@@ -0,0 +1,235 @@
+#include <bits/stdc++.h>
+#include "assignment_protocol.h"
+#include "assignment_service.h"
+#include "reviewer_assignment.h"
+#include "byte_io.h"
+using namespace std;
+using namespace protocol;
+
+// Usage: reviewer_loadgen [--socket path] [--clients 8] [--requests 200]
+//        [--papers 100] [--reviewers 30] [--delta-ratio 0.9] [--delta-ops 8]
+//        [--workers 0] [--check]
+//
+// Each client owns one session: it sends a full instance first, then a mix of
+// small cost deltas and full re-sends, timing every request until its Done
+// frame. Without --socket an in-process service is started on a temporary
+// socket. --check re-solves every request locally and compares the cost.
+
+struct LoadOptions {
+    string socket_path;
+    int clients = 8;
+    int requests = 200;
+    int papers = 100;
+    int reviewers = 30;
+    double delta_ratio = 0.9;
+    int delta_ops = 8;
+    int workers = 0;
+    bool check = false;
+};
+
+struct ClientReport {
+    vector<double> latency_ms;
+    long long assignments = 0;
+    int mismatches = 0;
+    int errors = 0;
+};
+
+// Same instance family as the experiments: complete bipartite graph, every
+// paper needs 3 reviews, costs in 1..10.
+struct ClientInstance {
+    int m, n;
+    vector<int> demand, capacity, cost;
+
+    ClientInstance(int m_in, int n_in, mt19937& rng)
+        : m(m_in), n(n_in), demand(m_in, 3), capacity(n_in, (m_in * 3) / n_in + 2),
+          cost((size_t)m_in * n_in) {
+        uniform_int_distribution<int> costDist(1, 10);
+        for (int &w : cost) w = costDist(rng);
+    }
+
+    void encode(ByteWriter& out) const {
+        out.put(m);
+        out.put(n);
+        for (int d : demand) out.put(d);
+        for (int c : capacity) out.put(c);
+        out.put<long long>(cost.size());
+        for (int p = 0; p < m; p++)
+            for (int r = 0; r < n; r++) {
+                out.put(p);
+                out.put(r);
+                out.put(cost[(size_t)p * n + r]);
+            }
+    }
+
+    int solveLocally() const {
+        ReviewerAssignment ra(m, n);
+        for (int p = 0; p < m; p++) ra.addPaperDemand(p, demand[p]);
+        for (int r = 0; r < n; r++) ra.addReviewerCapacity(r, capacity[r]);
+        for (int p = 0; p < m; p++)
+            for (int r = 0; r < n; r++) ra.addFeasibleEdge(p, r, cost[(size_t)p * n + r]);
+        AssignmentResult result = ra.computeAssignment();
+        return result.feasible ? result.cost : -1;
+    }
+};
+
+ClientReport runClient(const LoadOptions& opts, int client) {
+    ClientReport report;
+    mt19937 rng(42 + client);
+    ClientInstance inst(opts.papers, opts.reviewers, rng);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    uniform_int_distribution<int> paperDist(0, opts.papers - 1);
+    uniform_int_distribution<int> reviewerDist(0, opts.reviewers - 1);
+    uniform_int_distribution<int> costDist(1, 10);
+
+    uint32_t session = client + 1;
+    int fd = connectUnixSocket(opts.socket_path);
+    ByteWriter out;
+    vector<char> payload;
+
+    for (int req = 0; req < opts.requests; req++) {
+        bool delta = req > 0 && unit(rng) < opts.delta_ratio;
+        out.clear();
+        if (delta) {
+            out.put<long long>(opts.delta_ops);
+            for (int i = 0; i < opts.delta_ops; i++) {
+                int p = paperDist(rng), r = reviewerDist(rng), w = costDist(rng);
+                inst.cost[(size_t)p * inst.n + r] = w;
+                out.put((int)DeltaOp::SetEdge);
+                out.put(p);
+                out.put(r);
+                out.put(w);
+            }
+        } else {
+            inst.encode(out);
+        }
+
+        auto start = chrono::steady_clock::now();
+        MessageType type = delta ? MessageType::SolveDelta : MessageType::SolveInstance;
+        if (!writeFrame(fd, type, session, out.data(), out.size()))
+            throw runtime_error("connection closed by server");
+
+        FrameHeader header;
+        int cost = -1;
+        while (true) {
+            if (!readFrame(fd, header, payload)) throw runtime_error("connection closed by server");
+            ByteReader in(payload.data(), payload.size());
+            MessageType reply = (MessageType)header.type;
+            if (reply == MessageType::AssignmentChunk) {
+                report.assignments += in.get<long long>();
+            } else if (reply == MessageType::Done) {
+                int feasible = in.get<int>();
+                cost = feasible ? in.get<int>() : -1;
+                break;
+            } else {
+                report.errors++;
+                break;
+            }
+        }
+        auto end = chrono::steady_clock::now();
+        report.latency_ms.push_back(chrono::duration<double, milli>(end - start).count());
+
+        if (opts.check && cost != inst.solveLocally()) report.mismatches++;
+    }
+
+    writeFrame(fd, MessageType::CloseSession, session, nullptr, 0);
+    closeSocket(fd);
+    return report;
+}
+
+double percentile(const vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t rank = (size_t)ceil(q * sorted.size());
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+int main(int argc, char** argv) {
+    LoadOptions opts;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string flag = argv[i];
+            if (flag == "--check") {
+                opts.check = true;
+                continue;
+            }
+            if (i + 1 >= argc) throw invalid_argument("missing value for " + flag);
+            string value = argv[++i];
+
+            if (flag == "--socket") opts.socket_path = value;
+            else if (flag == "--clients") opts.clients = stoi(value);
+            else if (flag == "--requests") opts.requests = stoi(value);
+            else if (flag == "--papers") opts.papers = stoi(value);
+            else if (flag == "--reviewers") opts.reviewers = stoi(value);
+            else if (flag == "--delta-ratio") opts.delta_ratio = stod(value);
+            else if (flag == "--delta-ops") opts.delta_ops = stoi(value);
+            else if (flag == "--workers") opts.workers = stoi(value);
+            else throw invalid_argument("unknown flag " + flag);
+        }
+        if (opts.clients < 1 || opts.requests < 1 || opts.papers < 1 || opts.reviewers < 1)
+            throw invalid_argument("clients, requests, papers and reviewers must be positive");
+
+        unique_ptr<AssignmentService> service;
+        thread server;
+        if (opts.socket_path.empty()) {
+            opts.socket_path = (filesystem::temp_directory_path() /
+                ("reviewer_loadgen_" + to_string(random_device()()) + ".sock")).string();
+            service = make_unique<AssignmentService>(ServiceOptions{opts.socket_path, opts.workers});
+            server = thread([&] { service->run(); });
+        }
+
+        vector<ClientReport> reports(opts.clients);
+        vector<exception_ptr> failures(opts.clients);
+        auto start = chrono::steady_clock::now();
+        vector<thread> clients;
+        for (int c = 0; c < opts.clients; c++)
+            clients.emplace_back([&, c] {
+                try {
+                    reports[c] = runClient(opts, c);
+                } catch (...) {
+                    failures[c] = current_exception();
+                }
+            });
+        for (auto &t : clients) t.join();
+        auto end = chrono::steady_clock::now();
+
+        if (service) {
+            service->stop();
+            server.join();
+        }
+        for (auto &f : failures)
+            if (f) rethrow_exception(f);
+
+        vector<double> latency;
+        long long assignments = 0;
+        int mismatches = 0, errors = 0;
+        for (auto &r : reports) {
+            latency.insert(latency.end(), r.latency_ms.begin(), r.latency_ms.end());
+            assignments += r.assignments;
+            mismatches += r.mismatches;
+            errors += r.errors;
+        }
+        sort(latency.begin(), latency.end());
+        double seconds = chrono::duration<double>(end - start).count();
+        double mean = accumulate(latency.begin(), latency.end(), 0.0) / latency.size();
+
+        cout << "requests,clients,papers,reviewers,delta_ratio,throughput_rps,"
+                "mean_ms,p50_ms,p90_ms,p99_ms,max_ms,assignments,errors\n";
+        cout << latency.size() << "," << opts.clients << "," << opts.papers << ","
+             << opts.reviewers << "," << opts.delta_ratio << "," << fixed << setprecision(1)
+             << latency.size() / seconds << "," << setprecision(3) << mean << ","
+             << percentile(latency, 0.50) << "," << percentile(latency, 0.90) << ","
+             << percentile(latency, 0.99) << "," << latency.back() << ","
+             << assignments << "," << errors << "\n";
+
+        if (opts.check) {
+            cerr << (mismatches == 0 ? "check passed" : "check FAILED: ")
+                 << (mismatches == 0 ? "" : to_string(mismatches) + " cost mismatches") << "\n";
+            if (mismatches) return 1;
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
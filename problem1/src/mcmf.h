@@ -2,6 +2,7 @@
 #define MCMF_H
 
 #include <bits/stdc++.h>
+#include "delta_stepping.h"
 using namespace std;
 
 struct Edge {
@@ -10,53 +11,137 @@ struct Edge {
     int cost;
 };
 
+enum class ShortestPathKernel { Auto, Dijkstra, DeltaStepping };
+
 struct MinCostMaxFlow {
     int N;
     vector<vector<Edge>> G;
     vector<int> dist, parentV, parentE, potential;
+    long long arcs = 0;
+
+    // Auto switches to parallel delta-stepping once the residual graph has
+    // parallelArcThreshold arcs (reverse arcs included) and more than one
+    // thread is available. The threshold is 0 (never) until it has been
+    // measured on a multi-core machine with reviewer_mcmf_bench. Both kernels
+    // produce the same distances, and the augmenting path is chosen from the
+    // distances alone, so every phase, potential and the final flow are
+    // identical whichever kernel runs.
+    ShortestPathKernel kernel = ShortestPathKernel::Auto;
+    long long parallelArcThreshold = 0;  // 0 = Auto always uses Dijkstra
+    int nThreads = 0;    // 0 = all hardware threads
+    int deltaWidth = 0;  // bucket width; 0 = largest arc cost
 
     MinCostMaxFlow(int n)
         : N(n), G(n),
           dist(n), parentV(n), parentE(n), potential(n) {}
 
+    // Drops every edge but keeps the adjacency storage, so rebuilding a
+    // graph of similar shape reuses the previous allocations.
+    void reset(int n) {
+        N = n;
+        G.resize(n);
+        for (auto &adj : G) adj.clear();
+        arcs = 0;
+        dist.resize(n);
+        parentV.resize(n);
+        parentE.resize(n);
+        potential.resize(n);
+    }
+
     void addEdge(int u, int v, int cap, int cost) {
         Edge a = {v, (int)G[v].size(), cap, cost};
         Edge b = {u, (int)G[u].size(), 0, -cost};
         G[u].push_back(a);
         G[v].push_back(b);
+        arcs += 2;
+    }
+
+    int threadCount() const {
+        if (nThreads > 0) return nThreads;
+        int hw = (int)thread::hardware_concurrency();
+        return hw > 0 ? hw : 1;
+    }
+
+    bool useDeltaStepping() const {
+        if (kernel != ShortestPathKernel::Auto) return kernel == ShortestPathKernel::DeltaStepping;
+        return parallelArcThreshold > 0 && arcs >= parallelArcThreshold &&
+               threadCount() > 1;
+    }
+
+    void dijkstra(int s) {
+        fill(dist.begin(), dist.end(), INT_MAX);
+        dist[s] = 0;
+
+        priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> pq;
+        pq.push({0, s});
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.top();
+            pq.pop();
+            if (d != dist[u]) continue;
+
+            for (Edge &e : G[u]) {
+                if (e.cap > 0) {
+                    int nd = d + e.cost + potential[u] - potential[e.to];
+                    if (nd < dist[e.to]) {
+                        dist[e.to] = nd;
+                        pq.push({nd, e.to});
+                    }
+                }
+            }
+        }
+    }
+
+    // Walks tight residual arcs (reduced cost equal to the distance gap)
+    // backwards from t and records the path in parentV/parentE. Depth-first
+    // with backtracking, since zero-cost cycles can trap a greedy walk.
+    void tightPath(int s, int t) {
+        onWalk.assign(N, 0);
+        walk.clear();
+        walk.push_back({t, 0});
+        onWalk[t] = 1;
+
+        while (walk.back().first != s) {
+            int v = walk.back().first;
+            int &next = walk.back().second;
+            if (next == (int)G[v].size()) {
+                walk.pop_back();
+                continue;
+            }
+            const Edge &back = G[v][next++];
+            int u = back.to;
+            const Edge &e = G[u][back.rev];
+            if (onWalk[u] || e.cap <= 0 || dist[u] == INT_MAX) continue;
+            if (dist[u] + e.cost + potential[u] - potential[v] != dist[v]) continue;
+
+            parentV[v] = u;
+            parentE[v] = back.rev;
+            onWalk[u] = 1;
+            walk.push_back({u, 0});
+        }
     }
 
     pair<int, int> minCostMaxFlow(int s, int t, int maxFlow = INT_MAX) {
         int flow = 0, flowCost = 0;
         fill(potential.begin(), potential.end(), 0);
 
+        // The worker pool lives only for this solve, so idle networks (e.g.
+        // service sessions) hold no threads.
+        unique_ptr<DeltaStepping> deltaStepping;
+        int width = max(1, deltaWidth);
+        if (useDeltaStepping()) {
+            deltaStepping = make_unique<DeltaStepping>(threadCount());
+            if (deltaWidth <= 0)
+                for (auto &adj : G)
+                    for (Edge &e : adj) width = max(width, e.cost);
+        }
+
         while (flow < maxFlow) {
-            fill(dist.begin(), dist.end(), INT_MAX);
-            dist[s] = 0;
-
-            priority_queue<pair<int,int>, vector<pair<int,int>>, greater<pair<int,int>>> pq;
-            pq.push({0, s});
-
-            while (!pq.empty()) {
-                auto [d, u] = pq.top();
-                pq.pop();
-                if (d != dist[u]) continue;
-
-                for (int i = 0; i < (int)G[u].size(); i++) {
-                    Edge &e = G[u][i];
-                    if (e.cap > 0) {
-                        int nd = d + e.cost + potential[u] - potential[e.to];
-                        if (nd < dist[e.to]) {
-                            dist[e.to] = nd;
-                            parentV[e.to] = u;
-                            parentE[e.to] = i;
-                            pq.push({nd, e.to});
-                        }
-                    }
-                }
-            }
+            if (deltaStepping) deltaStepping->run(G, potential, s, width, dist);
+            else dijkstra(s);
 
             if (dist[t] == INT_MAX) break;
+            tightPath(s, t);
 
             for (int i = 0; i < N; i++)
                 if (dist[i] < INT_MAX)
@@ -87,6 +172,10 @@ struct MinCostMaxFlow {
 
         return {flow, flowCost};
     }
+
+private:
+    vector<char> onWalk;
+    vector<pair<int,int>> walk;
 };
 
 #endif
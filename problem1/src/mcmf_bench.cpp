@@ -0,0 +1,120 @@
+#include <bits/stdc++.h>
+#include "mcmf.h"
+using namespace std;
+
+// Usage: reviewer_mcmf_bench [--papers 20000] [--reviewers 500] [--phases 20]
+//        [--threads 0] [--width 0]
+//
+// Times the shortest-path phases of MinCostMaxFlow on one reviewer graph
+// (complete bipartite, 3 reviews per paper, costs in 1..10; the defaults give
+// 10M paper-reviewer edges) with the Dijkstra kernel and with delta-stepping
+// at 1, 2, 4, ... up to --threads workers. Each run stops after --phases
+// augmentations; "identical" checks flow, cost, last distances and
+// potentials against the Dijkstra run.
+
+struct BenchOptions {
+    int papers = 20000;
+    int reviewers = 500;
+    int phases = 20;
+    int threads = 0;
+    int width = 0;
+};
+
+struct BenchRun {
+    pair<int, int> result;
+    vector<int> dist, potential;
+    double ms;
+};
+
+static void buildGraph(MinCostMaxFlow& mcmf, const BenchOptions& opts) {
+    int m = opts.papers, n = opts.reviewers;
+    int S = 0, paperStart = 1, reviewerStart = paperStart + m, T = reviewerStart + n;
+    mcmf.reset(T + 1);
+
+    mt19937 rng(42);
+    uniform_int_distribution<int> costDist(1, 10);
+    for (int p = 0; p < m; p++) {
+        mcmf.G[paperStart + p].reserve(n + 1);
+        mcmf.addEdge(S, paperStart + p, 3, 0);
+    }
+    for (int p = 0; p < m; p++)
+        for (int r = 0; r < n; r++)
+            mcmf.addEdge(paperStart + p, reviewerStart + r, 1, costDist(rng));
+    for (int r = 0; r < n; r++)
+        mcmf.addEdge(reviewerStart + r, T, (m * 3) / n + 2, 0);
+}
+
+static BenchRun runKernel(MinCostMaxFlow& mcmf, const BenchOptions& opts,
+                          ShortestPathKernel kernel, int threads) {
+    buildGraph(mcmf, opts);
+    mcmf.kernel = kernel;
+    mcmf.nThreads = threads;
+    mcmf.deltaWidth = opts.width;
+
+    auto start = chrono::steady_clock::now();
+    BenchRun run;
+    run.result = mcmf.minCostMaxFlow(0, mcmf.N - 1, opts.phases);
+    run.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    run.dist = mcmf.dist;
+    run.potential = mcmf.potential;
+    return run;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string flag = argv[i];
+            if (i + 1 >= argc) throw invalid_argument("missing value for " + flag);
+            string value = argv[++i];
+
+            if (flag == "--papers") opts.papers = stoi(value);
+            else if (flag == "--reviewers") opts.reviewers = stoi(value);
+            else if (flag == "--phases") opts.phases = stoi(value);
+            else if (flag == "--threads") opts.threads = stoi(value);
+            else if (flag == "--width") opts.width = stoi(value);
+            else throw invalid_argument("unknown flag " + flag);
+        }
+        if (opts.papers < 1 || opts.reviewers < 1 || opts.phases < 1)
+            throw invalid_argument("papers, reviewers and phases must be positive");
+
+        MinCostMaxFlow mcmf(0);
+        int max_threads = opts.threads;
+        if (max_threads <= 0) {
+            mcmf.nThreads = 0;
+            max_threads = mcmf.threadCount();
+        }
+
+        BenchRun base = runKernel(mcmf, opts, ShortestPathKernel::Dijkstra, 1);
+        long long edges = (long long)opts.papers * opts.reviewers;
+
+        cout << "kernel,threads,edges,phases,total_ms,ms_per_phase,speedup,identical\n";
+        auto report = [&](const char* name, int threads, const BenchRun& run) {
+            bool identical = run.result == base.result && run.dist == base.dist &&
+                             run.potential == base.potential;
+            cout << name << "," << threads << "," << edges << "," << run.result.first << ","
+                 << fixed << setprecision(1) << run.ms << "," << setprecision(2)
+                 << run.ms / max(1, run.result.first) << "," << base.ms / run.ms << ","
+                 << identical << "\n";
+            return identical;
+        };
+
+        bool ok = report("dijkstra", 1, base);
+        for (int threads = 1;; threads = min(threads * 2, max_threads)) {
+            BenchRun run = runKernel(mcmf, opts, ShortestPathKernel::DeltaStepping, threads);
+            ok = report("delta-stepping", threads, run) && ok;
+            if (threads == max_threads) break;
+        }
+
+        if (!ok) {
+            cerr << "delta-stepping diverged from Dijkstra\n";
+            return 1;
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
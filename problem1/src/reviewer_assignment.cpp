@@ -1,5 +1,6 @@
 #include "reviewer_assignment.h"
 #include "mcmf.h"
+#include "result_cache.h"
 #include <bits/stdc++.h>
 using namespace std;
 
@@ -22,14 +23,64 @@ void ReviewerAssignment::addFeasibleEdge(int i, int j, int cost) {
     feasibleEdges.push_back({i, j, cost});
 }
 
-void ReviewerAssignment::solve() {
+void ReviewerAssignment::setResultCache(ResultCache* cache_in) {
+    cache = cache_in;
+}
+
+// Bump whenever the solver could return a different assignment.
+static const char* kSolverVersion = "mcmf-ssp-2";
+
+string ReviewerAssignment::canonicalBytes() const {
+    vector<tuple<int,int,int>> edges = feasibleEdges;
+    sort(edges.begin(), edges.end());
+
+    ByteWriter out;
+    out.put(m);
+    out.put(n);
+    out.putRange(k.begin(), k.end());
+    out.putRange(c.begin(), c.end());
+    out.put<long long>(edges.size());
+    for (auto &[p, r, w] : edges) {
+        out.put(p);
+        out.put(r);
+        out.put(w);
+    }
+    return out.str();
+}
+
+AssignmentResult ReviewerAssignment::computeAssignment() {
+    MinCostMaxFlow mcmf(0);
+    return computeAssignment(mcmf);
+}
+
+AssignmentResult ReviewerAssignment::computeAssignment(MinCostMaxFlow& mcmf) {
+    string key;
+    if (cache) {
+        key = ResultCache::makeKey("reviewer_assignment", kSolverVersion, canonicalBytes());
+        string payload;
+        if (cache->lookup(key, payload)) {
+            ByteReader in(payload);
+            AssignmentResult result;
+            result.feasible = in.get<char>();
+            result.cost = in.get<int>();
+            result.solve_ms = in.get<double>();
+            long long count = in.get<long long>();
+            for (long long i = 0; i < count; i++) {
+                int p = in.get<int>();
+                int r = in.get<int>();
+                result.assignments.push_back({p, r});
+            }
+            return result;
+        }
+    }
+
     int S = 0;
     int paperStart = 1;
     int reviewerStart = paperStart + m;
     int T = reviewerStart + n;
     int N = T + 1;
 
-    MinCostMaxFlow mcmf(N);
+    mcmf.reset(N);
 
     // Source → papers
     for (int p = 0; p < m; p++)
@@ -44,25 +95,53 @@ void ReviewerAssignment::solve() {
         mcmf.addEdge(reviewerStart + r, T, c[r], 0);
 
     int K = accumulate(k.begin(), k.end(), 0);
+
+    auto start = chrono::high_resolution_clock::now();
     auto [flow, cost] = mcmf.minCostMaxFlow(S, T, K);
+    auto end = chrono::high_resolution_clock::now();
+
+    AssignmentResult result;
+    result.feasible = flow == K;
+    result.cost = cost;
+    result.solve_ms = chrono::duration<double, milli>(end - start).count();
 
-    if (flow != K) {
+    // Extract assignments
+    if (result.feasible) {
+        for (int p = 0; p < m; p++) {
+            for (auto &e : mcmf.G[paperStart + p]) {
+                if (e.to >= reviewerStart && e.to < reviewerStart + n && e.cap == 0)
+                    result.assignments.push_back({p, e.to - reviewerStart});
+            }
+        }
+    }
+
+    if (cache) {
+        ByteWriter out;
+        out.put<char>(result.feasible);
+        out.put(result.cost);
+        out.put(result.solve_ms);
+        out.put<long long>(result.assignments.size());
+        for (auto &[p, r] : result.assignments) {
+            out.put(p);
+            out.put(r);
+        }
+        cache->store(key, out.str());
+    }
+
+    return result;
+}
+
+void ReviewerAssignment::solve() {
+    AssignmentResult result = computeAssignment();
+
+    if (!result.feasible) {
         cout << "Infeasible assignment.\n";
         return;
     }
 
-    cout << "Minimum total cost = " << cost << "\n";
+    cout << "Minimum total cost = " << result.cost << "\n";
     cout << "Assignments:\n";
 
-    // Extract assignments
-    for (int p = 0; p < m; p++) {
-        for (auto &e : mcmf.G[paperStart + p]) {
-            if (e.to >= reviewerStart && e.to < reviewerStart + n) {
-                int r = e.to - reviewerStart;
-                if (e.cap == 0) {
-                    cout << "Paper " << p << " assigned to Reviewer " << r << "\n";
-                }
-            }
-        }
-    }
+    for (auto &[p, r] : result.assignments)
+        cout << "Paper " << p << " assigned to Reviewer " << r << "\n";
 }
@@ -1,14 +1,27 @@
 #ifndef REVIEWER_ASSIGNMENT_H
 #define REVIEWER_ASSIGNMENT_H
 
+#include <string>
 #include <vector>
 #include <tuple>
+#include <utility>
+
+class ResultCache;
+struct MinCostMaxFlow;
+
+struct AssignmentResult {
+    bool feasible;
+    int cost;
+    std::vector<std::pair<int,int>> assignments; // (paper, reviewer)
+    double solve_ms; // min-cost flow time of the solve that produced this result
+};
 
 struct ReviewerAssignment {
     int m, n; // number of papers, reviewers
     std::vector<int> k; // paper demands
     std::vector<int> c; // reviewer capacities
     std::vector<std::tuple<int,int,int>> feasibleEdges;
+    ResultCache* cache = nullptr;
 
     ReviewerAssignment(int m_in, int n_in);
 
@@ -16,7 +29,20 @@ struct ReviewerAssignment {
     void addReviewerCapacity(int j, int cap);
     void addFeasibleEdge(int i, int j, int cost);
 
+    // Results are looked up in and stored to `cache_in` (may be null).
+    void setResultCache(ResultCache* cache_in);
+
+    // Demands, capacities and the edge list in sorted order, so the same
+    // instance hashes the same however its edges were added.
+    std::string canonicalBytes() const;
+
+    AssignmentResult computeAssignment();
+
+    // Builds the flow graph in `network`, reusing its storage; long-lived
+    // callers keep one network per instance to avoid reallocating.
+    AssignmentResult computeAssignment(MinCostMaxFlow& network);
+
     void solve();
 };
 
-#endif // REVIEWER_ASSIGNMENT_H
\ No newline at end of file
+#endif // REVIEWER_ASSIGNMENT_H
@@ -0,0 +1,85 @@
+#include <bits/stdc++.h>
+#include "arena.h"
+#include "generators.h"
+#include "set_cover_solver.h"
+using namespace std;
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Usage: setcover_alloc_bench [n_elements] [n_sets] [density]
+//
+// Builds the tree-based instance, the solver's private copy and a tree greedy
+// solution once with per-node heap allocation ("heap", the original layout)
+// and once inside a SetCoverArena ("arena"), reporting system allocations,
+// peak bytes held, phase timings and peak RSS. The layout's resource is also
+// the default resource while it runs, so the greedy's scratch (its uncovered
+// copy) is counted too. Each layout runs in its own child
+// process so peak RSS is not shared between them.
+
+void runLayout(const string& layout, const FlatSetCoverInstance& flat) {
+    CountingResource heap;
+    SetCoverArena arena;
+    pmr::memory_resource* mem = layout == "arena" ? arena.resource() : &heap;
+    pmr::memory_resource* previous = pmr::set_default_resource(mem);
+
+    long long rss_before = peakResidentKb();
+    auto ms = [](auto a, auto b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+
+    auto t0 = chrono::steady_clock::now();
+    int cost;
+    chrono::steady_clock::time_point t1, t2;
+    {
+        auto instance = make_unique<SetCoverInstance>(toSetCoverInstance(flat, mem));
+        auto solver = make_unique<SetCoverSolver>(*instance, mem);
+        t1 = chrono::steady_clock::now();
+
+        SetCoverSolution solution = solver->solveGreedy();
+        cost = solution.cost;
+        t2 = chrono::steady_clock::now();
+    }
+    arena.release();
+    auto t3 = chrono::steady_clock::now();
+    pmr::set_default_resource(previous);
+
+    AllocationStats stats = layout == "arena" ? arena.stats() : heap.stats();
+    cout << layout << "," << flat.n_elements << "," << flat.n_sets << ","
+         << flat.elements.size() << "," << cost << "," << stats.allocations << ","
+         << stats.peak_bytes_in_use / 1024 << "," << fixed << setprecision(3)
+         << ms(t0, t1) << "," << ms(t1, t2) << "," << ms(t2, t3) << ","
+         << peakResidentKb() - rss_before << "\n";
+    cout.flush();
+}
+
+int main(int argc, char** argv) {
+    int n_elements = argc > 1 ? stoi(argv[1]) : 10000;
+    int n_sets = argc > 2 ? stoi(argv[2]) : 15000;
+    double density = argc > 3 ? stod(argv[3]) : 0.01;
+
+    FlatSetCoverInstance flat = generateFlatSetCover(n_elements, n_sets, density, 42);
+
+    cout << "Layout,Elements,Sets,SetEntries,Cost,Allocations,PeakHeld_KB,"
+            "Build_ms,Solve_ms,Teardown_ms,PeakRSS_Delta_KB\n";
+    cout.flush();
+
+    for (string layout : {"heap", "arena"}) {
+#ifndef _WIN32
+        pid_t pid = fork();
+        if (pid == 0) {
+            runLayout(layout, flat);
+            _exit(0);
+        }
+        if (pid > 0) {
+            waitpid(pid, nullptr, 0);
+            continue;
+        }
+#endif
+        runLayout(layout, flat);
+    }
+
+    return 0;
+}
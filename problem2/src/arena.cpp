@@ -0,0 +1,56 @@
+#include "arena.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+CountingResource::CountingResource(pmr::memory_resource* upstream)
+    : upstream_(upstream) {}
+
+AllocationStats CountingResource::stats() const {
+    return {allocations_.load(), deallocations_.load(),
+            bytes_allocated_.load(), peak_bytes_.load()};
+}
+
+void CountingResource::resetStats() {
+    allocations_ = deallocations_ = bytes_allocated_ = 0;
+    peak_bytes_ = bytes_in_use_.load();
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    void* p = upstream_->allocate(bytes, alignment);
+    allocations_.fetch_add(1, memory_order_relaxed);
+    bytes_allocated_.fetch_add(bytes, memory_order_relaxed);
+
+    long long in_use = bytes_in_use_.fetch_add(bytes, memory_order_relaxed) + bytes;
+    long long peak = peak_bytes_.load(memory_order_relaxed);
+    while (in_use > peak && !peak_bytes_.compare_exchange_weak(peak, in_use, memory_order_relaxed)) {}
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+    deallocations_.fetch_add(1, memory_order_relaxed);
+    bytes_in_use_.fetch_sub(bytes, memory_order_relaxed);
+}
+
+bool CountingResource::do_is_equal(const pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+SetCoverArena::SetCoverArena(size_t initial_block_bytes)
+    : monotonic_(initial_block_bytes, &counter_) {}
+
+long long peakResidentKb() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
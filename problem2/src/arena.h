@@ -0,0 +1,59 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <bits/stdc++.h>
+#include <memory_resource>
+using namespace std;
+
+struct AllocationStats {
+    long long allocations;
+    long long deallocations;
+    long long bytes_allocated;
+    long long peak_bytes_in_use;
+};
+
+// Forwards to an upstream resource and counts every call that reaches it.
+// Wrapping new_delete_resource() measures the plain per-node heap layout;
+// as an arena's upstream it counts the arena's block requests.
+class CountingResource : public pmr::memory_resource {
+public:
+    explicit CountingResource(pmr::memory_resource* upstream = pmr::new_delete_resource());
+
+    AllocationStats stats() const;
+    void resetStats();
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override;
+
+    pmr::memory_resource* upstream_;
+    atomic<long long> allocations_{0}, deallocations_{0};
+    atomic<long long> bytes_allocated_{0}, bytes_in_use_{0}, peak_bytes_{0};
+};
+
+// Monotonic arena for instance and solution storage. Allocation is a pointer
+// bump into large blocks; deallocation is a no-op and release() returns every
+// block at once. Not thread-safe: use one arena per worker.
+class SetCoverArena {
+public:
+    explicit SetCoverArena(size_t initial_block_bytes = 1 << 16);
+
+    pmr::memory_resource* resource() { return &monotonic_; }
+
+    // Frees everything allocated so far. Containers built on the arena must
+    // already be destroyed.
+    void release() { monotonic_.release(); }
+
+    // Counts the blocks the arena requested from the system heap.
+    AllocationStats stats() const { return counter_.stats(); }
+
+private:
+    CountingResource counter_;
+    pmr::monotonic_buffer_resource monotonic_;
+};
+
+// Peak resident set size of this process in KiB, or -1 where unsupported.
+long long peakResidentKb();
+
+#endif
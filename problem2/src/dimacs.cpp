@@ -0,0 +1,236 @@
+#include "dimacs.h"
+#include "parallel.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t kMinChunkBytes = 1 << 20;
+
+// Read-only view of a whole file: mmap where available, a plain read on
+// platforms without it.
+class MappedFile {
+public:
+    explicit MappedFile(const string& path) {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("cannot open " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw runtime_error("cannot stat " + path);
+        }
+
+        size_ = st.st_size;
+        if (size_ > 0) {
+            void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("cannot mmap " + path);
+            }
+            madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+        }
+        close(fd);
+#else
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("cannot open " + path);
+        fallback_.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (size_ > 0) munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    string fallback_;
+#endif
+};
+
+struct ChunkResult {
+    vector<int> literals;
+    vector<long long> clause_ends;  // literals.size() at each terminating 0
+    bool saw_end = false;           // hit a SATLIB-style '%' end marker
+    string error;
+};
+
+bool isSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\f' || ch == '\v';
+}
+
+const char* skipLine(const char* p, const char* end) {
+    const void* nl = memchr(p, '\n', end - p);
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+void parseChunk(const char* p, const char* end, int n_variables, ChunkResult& out) {
+    while (p < end) {
+        char ch = *p;
+        if (isSpace(ch)) {
+            p++;
+        } else if (ch == 'c') {
+            p = skipLine(p, end);
+        } else if (ch == '%') {
+            out.saw_end = true;
+            return;
+        } else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+            bool negative = ch == '-';
+            if (negative) p++;
+            if (p >= end || *p < '0' || *p > '9') {
+                out.error = "malformed literal";
+                return;
+            }
+
+            long long value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                value = value * 10 + (*p++ - '0');
+                if (value > n_variables) {
+                    out.error = "literal exceeds declared variable count";
+                    return;
+                }
+            }
+
+            if (value == 0)
+                out.clause_ends.push_back(out.literals.size());
+            else
+                out.literals.push_back(negative ? -(int)value : (int)value);
+        } else {
+            out.error = string("unexpected character '") + ch + "'";
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+FlatCnfFormula readDimacsCnf(const string& path, int n_threads) {
+    MappedFile file(path);
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    // The header is tiny, so it is located serially.
+    FlatCnfFormula formula;
+    long long declared_vars = -1, declared_clauses = -1;
+    while (p < end && declared_vars < 0) {
+        if (isSpace(*p)) {
+            p++;
+        } else if (*p == 'c') {
+            p = skipLine(p, end);
+        } else if (*p == 'p') {
+            const char* line_end = skipLine(p, end);
+            string header(p, line_end);
+            char fmt[8] = {0};
+            if (sscanf(header.c_str(), "p %7s %lld %lld", fmt, &declared_vars,
+                       &declared_clauses) != 3 || string(fmt) != "cnf" ||
+                declared_vars < 0 || declared_vars > INT_MAX || declared_clauses < 0)
+                throw runtime_error(path + ": malformed problem line");
+            p = line_end;
+        } else {
+            throw runtime_error(path + ": clauses before problem line");
+        }
+    }
+    if (declared_vars < 0) throw runtime_error(path + ": missing problem line");
+    formula.n_variables = (int)declared_vars;
+
+    // Cut the clause section into line-aligned chunks.
+    int workers = resolveThreadCount(n_threads);
+    size_t body = end - p;
+    size_t n_chunks = max<size_t>(1, min<size_t>(4 * workers, body / kMinChunkBytes));
+
+    vector<const char*> cuts(n_chunks + 1, end);
+    cuts[0] = p;
+    for (size_t k = 1; k < n_chunks; k++) {
+        const char* cut = p + body * k / n_chunks;
+        cuts[k] = max(cuts[k - 1], cut == p ? p : skipLine(cut - 1, end));
+    }
+
+    vector<ChunkResult> chunks(n_chunks);
+    parallelFor(n_chunks, 1, workers, [&](long long begin, long long stop) {
+        for (long long k = begin; k < stop; k++) {
+            chunks[k].literals.reserve((cuts[k + 1] - cuts[k]) / 3);
+            parseChunk(cuts[k], cuts[k + 1], formula.n_variables, chunks[k]);
+        }
+    });
+
+    // Chunks past a '%' marker are ignored; errors are reported in file order.
+    size_t used = n_chunks;
+    for (size_t k = 0; k < n_chunks; k++) {
+        if (!chunks[k].error.empty())
+            throw runtime_error(path + ": " + chunks[k].error);
+        if (chunks[k].saw_end) {
+            used = k + 1;
+            break;
+        }
+    }
+
+    vector<long long> literal_base(used + 1, 0), clause_base(used + 1, 0);
+    for (size_t k = 0; k < used; k++) {
+        literal_base[k + 1] = literal_base[k] + chunks[k].literals.size();
+        clause_base[k + 1] = clause_base[k] + chunks[k].clause_ends.size();
+    }
+
+    // A clause may straddle a chunk cut; offsets are global, so it still
+    // comes out whole. A final clause missing its 0 is accepted.
+    long long n_literals = literal_base[used];
+    long long n_clauses = clause_base[used];
+    long long terminated = 0;
+    for (size_t k = used; k-- > 0;) {
+        if (!chunks[k].clause_ends.empty()) {
+            terminated = literal_base[k] + chunks[k].clause_ends.back();
+            break;
+        }
+    }
+    bool unterminated = n_literals > terminated;
+    if (n_clauses + unterminated > INT_MAX)
+        throw runtime_error(path + ": too many clauses");
+
+    formula.n_clauses = (int)(n_clauses + unterminated);
+    formula.offsets.assign(formula.n_clauses + 1, 0);
+    formula.literals.resize(n_literals);
+    if (unterminated) formula.offsets[formula.n_clauses] = n_literals;
+
+    parallelFor(used, 1, workers, [&](long long begin, long long stop) {
+        for (long long k = begin; k < stop; k++) {
+            ChunkResult& chunk = chunks[k];
+            copy(chunk.literals.begin(), chunk.literals.end(),
+                 formula.literals.begin() + literal_base[k]);
+            for (size_t j = 0; j < chunk.clause_ends.size(); j++)
+                formula.offsets[clause_base[k] + j + 1] = literal_base[k] + chunk.clause_ends[j];
+            vector<int>().swap(chunk.literals);
+        }
+    });
+
+    return formula;
+}
+
+void writeDimacsCnf(const string& path, const FlatCnfFormula& formula) {
+    ofstream out(path);
+    if (!out) throw runtime_error("cannot write " + path);
+
+    out << "p cnf " << formula.n_variables << " " << formula.n_clauses << "\n";
+    for (int c = 0; c < formula.n_clauses; c++) {
+        for (long long k = formula.offsets[c]; k < formula.offsets[c + 1]; k++)
+            out << formula.literals[k] << " ";
+        out << "0\n";
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef DIMACS_H
+#define DIMACS_H
+
+#include "sat_reduction.h"
+
+// Reads a DIMACS CNF file ("p cnf <vars> <clauses>", clauses terminated by 0).
+// The file is memory-mapped and its clause section is parsed in parallel
+// chunks split on line boundaries. Throws runtime_error on malformed input.
+FlatCnfFormula readDimacsCnf(const string& path, int n_threads = 0);
+
+void writeDimacsCnf(const string& path, const FlatCnfFormula& formula);
+
+#endif
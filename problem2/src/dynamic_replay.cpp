@@ -0,0 +1,120 @@
+#include <bits/stdc++.h>
+#include "dynamic_set_cover.h"
+#include "generators.h"
+#include "set_cover_solver.h"
+using namespace std;
+
+// Usage: setcover_dynamic_replay [n_elements] [n_sets] [density] [updates]
+//        [checkpoint] [seed] [--check]
+//
+// Replays a random stream of element arrivals/departures and set
+// openings/closures against DynamicSetCover. Every `checkpoint` updates the
+// live instance is also re-solved from scratch with the lazy greedy. Each
+// row compares cover sizes, the mean dynamic update time and the cost of
+// one full re-solve. --check verifies the invariants at every checkpoint.
+
+// Live ids with O(1) random pick and removal.
+struct IdPool {
+    vector<int> ids, pos;
+
+    void add(int id) {
+        if ((int)pos.size() <= id) pos.resize(id + 1, -1);
+        pos[id] = ids.size();
+        ids.push_back(id);
+    }
+
+    void remove(int id) {
+        int last = ids.back();
+        ids[pos[id]] = last;
+        pos[last] = pos[id];
+        ids.pop_back();
+        pos[id] = -1;
+    }
+
+    int pick(mt19937_64& rng) const { return ids[rng() % ids.size()]; }
+};
+
+int main(int argc, char** argv) {
+    vector<string> args(argv + 1, argv + argc);
+    bool check = find(args.begin(), args.end(), "--check") != args.end();
+    args.erase(remove(args.begin(), args.end(), "--check"), args.end());
+
+    int n_elements = args.size() > 0 ? stoi(args[0]) : 10000;
+    int n_sets = args.size() > 1 ? stoi(args[1]) : 15000;
+    double density = args.size() > 2 ? stod(args[2]) : 0.01;
+    int updates = args.size() > 3 ? stoi(args[3]) : 20000;
+    int checkpoint = args.size() > 4 ? max(1, stoi(args[4])) : 2000;
+    uint64_t seed = args.size() > 5 ? stoull(args[5]) : 42;
+
+    FlatSetCoverInstance initial = generateFlatSetCover(n_elements, n_sets, density, seed);
+
+    auto t0 = chrono::steady_clock::now();
+    DynamicSetCover dyn(initial);
+    auto t1 = chrono::steady_clock::now();
+    cerr << "initial build " << chrono::duration<double, milli>(t1 - t0).count()
+         << " ms, cover " << dyn.coverSize() << "\n";
+
+    IdPool elements, sets;
+    for (int e = 0; e < n_elements; e++) elements.add(e);
+    for (int s = 0; s < n_sets; s++) sets.add(s);
+
+    mt19937_64 rng(seed ^ 0xd1b54a32d192ed03ULL);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+
+    cout << "Updates,Live_Elements,Live_Sets,Dynamic_Cover,Static_Cover,Cover_Ratio,"
+            "Dynamic_Update_us,Static_Resolve_us,Speedup,Reassignments,Invariants\n";
+    cout << fixed << setprecision(3);
+
+    double window_us = 0;
+    int window_ops = 0;
+    for (int u = 1; u <= updates; u++) {
+        double op = coin(rng);
+        vector<int> picked;
+
+        auto start = chrono::steady_clock::now();
+        if (op < 0.40 || elements.ids.empty()) {
+            int k = max(1, (int)lround(density * sets.ids.size()));
+            for (int i = 0; i < k && !sets.ids.empty(); i++) picked.push_back(sets.pick(rng));
+            start = chrono::steady_clock::now();
+            elements.add(dyn.insertElement(picked));
+        } else if (op < 0.70) {
+            int e = elements.pick(rng);
+            start = chrono::steady_clock::now();
+            dyn.deleteElement(e);
+            elements.remove(e);
+        } else if (op < 0.85 || sets.ids.size() < 2) {
+            int k = max(1, (int)lround(density * elements.ids.size()));
+            for (int i = 0; i < k; i++) picked.push_back(elements.pick(rng));
+            start = chrono::steady_clock::now();
+            sets.add(dyn.insertSet(picked));
+        } else {
+            int s = sets.pick(rng);
+            start = chrono::steady_clock::now();
+            dyn.deleteSet(s);
+            sets.remove(s);
+        }
+        window_us += chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        window_ops++;
+
+        if (u % checkpoint != 0 && u != updates) continue;
+
+        FlatSetCoverInstance live = dyn.snapshot();
+        auto r0 = chrono::steady_clock::now();
+        SetCoverSolution fresh = FlatSetCoverSolver(live).solveLazyGreedy();
+        auto r1 = chrono::steady_clock::now();
+
+        double update_us = window_us / window_ops;
+        double resolve_us = chrono::duration<double, micro>(r1 - r0).count();
+        cout << u << "," << elements.ids.size() << "," << sets.ids.size() << ","
+             << dyn.coverSize() << "," << fresh.cost << ","
+             << (double)dyn.coverSize() / max(1, fresh.cost) << "," << update_us
+             << "," << resolve_us << "," << resolve_us / max(1e-3, update_us) << ","
+             << dyn.reassignments() << ","
+             << (check ? (dyn.checkInvariants() ? "ok" : "FAILED") : "skipped") << "\n";
+
+        window_us = 0;
+        window_ops = 0;
+    }
+
+    return 0;
+}
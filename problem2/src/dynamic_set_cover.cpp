@@ -0,0 +1,399 @@
+#include "dynamic_set_cover.h"
+#include "set_cover_solver.h"
+
+namespace {
+
+int floorLog2(size_t x) {
+    int lvl = 0;
+    while (x >>= 1) lvl++;
+    return lvl;
+}
+
+}  // namespace
+
+DynamicSetCover::DynamicSetCover(const FlatSetCoverInstance& initial) {
+    for (int i = 0; i < initial.n_sets; i++) newSet();
+    for (int e = 0; e < initial.n_elements; e++) newElement();
+    for (int i = 0; i < initial.n_sets; i++)
+        for (long long k = initial.offsets[i]; k < initial.offsets[i + 1]; k++)
+            addIncidence(i, initial.elements[k]);
+
+    // Greedy gains only shrink, so a set picked while covering g new
+    // elements lands on level floor(log2 g) and no set can violate
+    // stability: at that moment every set had fewer than 2g uncovered.
+    SetCoverSolution greedy = FlatSetCoverSolver(initial).solveLazyGreedy();
+    vector<int> fresh;
+    for (int s : greedy.selected_sets) {
+        fresh.clear();
+        for (long long k = initial.offsets[s]; k < initial.offsets[s + 1]; k++)
+            if (owner[initial.elements[k]] < 0) fresh.push_back(initial.elements[k]);
+        if (fresh.empty()) continue;
+
+        set_level[s] = floorLog2(fresh.size());
+        cover_size++;
+        for (int e : fresh) {
+            attach(e, s);
+            moveLevel(e, -1, set_level[s]);
+        }
+    }
+
+    for (int e = 0; e < initial.n_elements; e++)
+        if (owner[e] < 0) uncovered++;
+
+    stabilize();
+}
+
+int DynamicSetCover::insertElement(const vector<int>& covering_sets) {
+    int e = newElement();
+
+    vector<int> sets = covering_sets;
+    sort(sets.begin(), sets.end());
+    sets.erase(unique(sets.begin(), sets.end()), sets.end());
+    for (int s : sets)
+        if (s >= 0 && s < (int)set_alive.size() && set_alive[s]) addIncidence(s, e);
+
+    placeOrphan(e);
+    stabilize();
+    return e;
+}
+
+void DynamicSetCover::deleteElement(int elem) {
+    if (elem < 0 || elem >= (int)elem_alive.size() || !elem_alive[elem]) return;
+    elem_alive[elem] = 0;
+
+    if (owner[elem] < 0) {
+        uncovered--;
+    } else {
+        int t = owner[elem];
+        moveLevel(elem, level(elem), -1);
+        detach(elem);
+        fall(t);
+    }
+
+    for (int id : elem_incs[elem]) {
+        unlinkFromSet(id);
+        free_incs.push_back(id);
+    }
+    vector<int>().swap(elem_incs[elem]);
+    stabilize();
+}
+
+int DynamicSetCover::insertSet(const vector<int>& elements) {
+    int s = newSet();
+
+    vector<int> elems = elements, orphans;
+    sort(elems.begin(), elems.end());
+    elems.erase(unique(elems.begin(), elems.end()), elems.end());
+    for (int e : elems) {
+        if (e < 0 || e >= (int)elem_alive.size() || !elem_alive[e]) continue;
+        addIncidence(s, e);
+        if (owner[e] >= 0)
+            bucketInsert(set_incs[s].back(), level(e));
+        else
+            orphans.push_back(e);
+    }
+
+    for (int e : orphans) {
+        uncovered--;
+        placeOrphan(e);
+    }
+
+    markDirty(s);
+    stabilize();
+    return s;
+}
+
+void DynamicSetCover::deleteSet(int set_id) {
+    if (set_id < 0 || set_id >= (int)set_alive.size() || !set_alive[set_id]) return;
+    set_alive[set_id] = 0;
+
+    for (int id : set_incs[set_id]) {
+        int lvl = level(inc[id].elem);
+        if (lvl >= 0) bucketErase(id, lvl);
+        unlinkFromElement(id);
+        free_incs.push_back(id);
+    }
+    vector<int>().swap(set_incs[set_id]);
+
+    vector<int> orphans;
+    orphans.swap(members[set_id]);
+    int old_level = set_level[set_id];
+    if (old_level >= 0) cover_size--;
+    set_level[set_id] = -1;
+
+    for (int e : orphans) {
+        owner[e] = -1;
+        moveLevel(e, old_level, -1);
+        placeOrphan(e);
+        moves++;
+    }
+
+    vector<vector<int>>().swap(bucket[set_id]);
+    stabilize();
+}
+
+vector<int> DynamicSetCover::coverSets() const {
+    vector<int> cover;
+    for (int s = 0; s < (int)set_level.size(); s++)
+        if (set_level[s] >= 0) cover.push_back(s);
+    return cover;
+}
+
+FlatSetCoverInstance DynamicSetCover::snapshot() const {
+    FlatSetCoverInstance flat;
+    flat.n_elements = elem_alive.size();
+    flat.n_sets = set_alive.size();
+    flat.offsets.assign(flat.n_sets + 1, 0);
+
+    vector<int> row;
+    for (int s = 0; s < flat.n_sets; s++) {
+        row.clear();
+        if (set_alive[s])
+            for (int id : set_incs[s]) row.push_back(inc[id].elem);
+        sort(row.begin(), row.end());
+        flat.elements.insert(flat.elements.end(), row.begin(), row.end());
+        flat.offsets[s + 1] = flat.elements.size();
+    }
+
+    return flat;
+}
+
+bool DynamicSetCover::checkInvariants() const {
+    int n_sets = set_alive.size(), n_elements = elem_alive.size();
+    int cover = 0, orphans = 0;
+
+    for (int e = 0; e < n_elements; e++) {
+        if (!elem_alive[e]) continue;
+        bool coverable = false, owner_contains = false;
+        for (int id : elem_incs[e]) {
+            coverable = true;
+            owner_contains |= inc[id].set_id == owner[e];
+        }
+        if (!coverable) {
+            if (owner[e] >= 0) return false;
+            orphans++;
+        } else if (!owner_contains || members[owner[e]][member_pos[e]] != e) {
+            return false;
+        }
+    }
+
+    for (int s = 0; s < n_sets; s++) {
+        if ((set_level[s] >= 0) != !members[s].empty()) return false;
+        if (set_level[s] < 0) continue;
+        if (!set_alive[s] || members[s].size() < (size_t)1 << set_level[s]) return false;
+        cover++;
+
+        vector<long long> count;
+        for (int id : set_incs[s]) {
+            int lvl = level(inc[id].elem);
+            if (lvl < 0) return false;
+            if ((int)count.size() <= lvl) count.resize(lvl + 1, 0);
+            count[lvl]++;
+        }
+        for (size_t lvl = 0; lvl < count.size(); lvl++)
+            if (lvl >= bucket[s].size() ? count[lvl] != 0
+                                        : (long long)bucket[s][lvl].size() != count[lvl])
+                return false;
+    }
+
+    for (int s = 0; s < n_sets; s++)
+        if (set_alive[s] && violatedLevel(s) > 0) return false;
+
+    return cover == cover_size && orphans == uncovered;
+}
+
+int DynamicSetCover::newSet() {
+    set_incs.emplace_back();
+    bucket.emplace_back();
+    set_alive.push_back(1);
+    set_level.push_back(-1);
+    members.emplace_back();
+    in_dirty.push_back(0);
+    return set_alive.size() - 1;
+}
+
+int DynamicSetCover::newElement() {
+    elem_incs.emplace_back();
+    elem_alive.push_back(1);
+    owner.push_back(-1);
+    member_pos.push_back(-1);
+    return elem_alive.size() - 1;
+}
+
+void DynamicSetCover::addIncidence(int set_id, int elem) {
+    int id;
+    if (free_incs.empty()) {
+        id = inc.size();
+        inc.emplace_back();
+    } else {
+        id = free_incs.back();
+        free_incs.pop_back();
+    }
+    inc[id] = {set_id, elem, -1, (int)set_incs[set_id].size(), (int)elem_incs[elem].size()};
+    set_incs[set_id].push_back(id);
+    elem_incs[elem].push_back(id);
+}
+
+void DynamicSetCover::unlinkFromSet(int id) {
+    vector<int>& list = set_incs[inc[id].set_id];
+    int last = list.back();
+    list[inc[id].set_slot] = last;
+    inc[last].set_slot = inc[id].set_slot;
+    list.pop_back();
+}
+
+void DynamicSetCover::unlinkFromElement(int id) {
+    vector<int>& list = elem_incs[inc[id].elem];
+    int last = list.back();
+    list[inc[id].elem_slot] = last;
+    inc[last].elem_slot = inc[id].elem_slot;
+    list.pop_back();
+}
+
+void DynamicSetCover::markDirty(int set_id) {
+    if (in_dirty[set_id]) return;
+    in_dirty[set_id] = 1;
+    dirty.push_back(set_id);
+}
+
+void DynamicSetCover::bucketInsert(int id, int lvl) {
+    vector<vector<int>>& levels = bucket[inc[id].set_id];
+    if ((int)levels.size() <= lvl) levels.resize(lvl + 1);
+    inc[id].pos = levels[lvl].size();
+    levels[lvl].push_back(id);
+}
+
+void DynamicSetCover::bucketErase(int id, int lvl) {
+    vector<int>& b = bucket[inc[id].set_id][lvl];
+    int last = b.back();
+    b[inc[id].pos] = last;
+    inc[last].pos = inc[id].pos;
+    b.pop_back();
+    inc[id].pos = -1;
+}
+
+// Re-buckets every live incidence of elem. Only a drop in level (or a new
+// level) can push a set over a stability threshold, so only then is the set
+// queued for a check.
+void DynamicSetCover::moveLevel(int elem, int old_level, int new_level) {
+    if (old_level == new_level) return;
+    for (int id : elem_incs[elem]) {
+        if (old_level >= 0) bucketErase(id, old_level);
+        if (new_level >= 0) bucketInsert(id, new_level);
+        if (new_level >= 0 && (old_level < 0 || new_level < old_level))
+            markDirty(inc[id].set_id);
+    }
+}
+
+void DynamicSetCover::attach(int elem, int set_id) {
+    owner[elem] = set_id;
+    member_pos[elem] = members[set_id].size();
+    members[set_id].push_back(elem);
+}
+
+void DynamicSetCover::detach(int elem) {
+    vector<int>& m = members[owner[elem]];
+    int last = m.back();
+    m[member_pos[elem]] = last;
+    member_pos[last] = member_pos[elem];
+    m.pop_back();
+    owner[elem] = member_pos[elem] = -1;
+}
+
+// An unassigned live element joins the highest-level cover set containing
+// it, or opens a level-0 set if none of its sets is in the cover.
+void DynamicSetCover::placeOrphan(int elem) {
+    int best = -1;
+    for (int id : elem_incs[elem]) {
+        int s = inc[id].set_id;
+        if (best < 0 || set_level[s] > set_level[best]) best = s;
+    }
+
+    if (best < 0) {
+        uncovered++;
+        return;
+    }
+
+    if (set_level[best] < 0) {
+        set_level[best] = 0;
+        cover_size++;
+    }
+    attach(elem, best);
+    moveLevel(elem, -1, set_level[best]);
+}
+
+void DynamicSetCover::fall(int set_id) {
+    int old_level = set_level[set_id];
+    if (old_level < 0) return;
+
+    size_t size = members[set_id].size();
+    if (size == 0) {
+        set_level[set_id] = -1;
+        cover_size--;
+        return;
+    }
+    if (size >= (size_t)1 << old_level) return;
+
+    int new_level = floorLog2(size);
+    set_level[set_id] = new_level;
+    for (int e : members[set_id]) moveLevel(e, old_level, new_level);
+}
+
+// Largest k with at least 2^(k+1) elements of the set below level k, or 0.
+int DynamicSetCover::violatedLevel(int set_id) const {
+    long long below = 0;
+    int worst = 0;
+    for (size_t lvl = 0; lvl < bucket[set_id].size(); lvl++) {
+        below += bucket[set_id][lvl].size();
+        int k = lvl + 1;
+        if (k < 62 && below >= 1LL << (k + 1)) worst = k;
+    }
+    return worst;
+}
+
+// The set takes over every element it holds below level k. It ends at a
+// level above k, so the taken elements strictly rise; the sets they left
+// may fall.
+void DynamicSetCover::rise(int set_id, int k) {
+    vector<int> taken;
+    for (int lvl = 0; lvl < k && lvl < (int)bucket[set_id].size(); lvl++)
+        for (int id : bucket[set_id][lvl]) taken.push_back(inc[id].elem);
+
+    int own_level = set_level[set_id];
+    size_t own_count = members[set_id].size();
+    vector<int> old_levels(taken.size()), losers;
+
+    for (size_t i = 0; i < taken.size(); i++) {
+        int e = taken[i];
+        old_levels[i] = level(e);
+        if (owner[e] == set_id) continue;
+        losers.push_back(owner[e]);
+        detach(e);
+        attach(e, set_id);
+        moves++;
+    }
+
+    if (own_level < 0) cover_size++;
+    int new_level = max(own_level, floorLog2(members[set_id].size()));
+    set_level[set_id] = new_level;
+
+    for (size_t i = 0; i < taken.size(); i++)
+        moveLevel(taken[i], old_levels[i], new_level);
+    if (own_level >= k)
+        for (size_t i = 0; i < own_count; i++)
+            moveLevel(members[set_id][i], own_level, new_level);
+
+    for (int t : losers) fall(t);
+}
+
+void DynamicSetCover::stabilize() {
+    while (!dirty.empty()) {
+        int s = dirty.back();
+        dirty.pop_back();
+        in_dirty[s] = 0;
+        if (!set_alive[s]) continue;
+
+        int k = violatedLevel(s);
+        if (k > 0) rise(s, k);
+    }
+}
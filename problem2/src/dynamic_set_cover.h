@@ -0,0 +1,95 @@
+#ifndef DYNAMIC_SET_COVER_H
+#define DYNAMIC_SET_COVER_H
+
+#include "set_cover_instance.h"
+
+// Set cover maintained under element and set insertions/deletions with a
+// level-based dynamic greedy.
+//
+// Every covered element is assigned to one cover set; a cover set S sits at
+// level lev(S) and owns A(S) with |A(S)| >= 2^lev(S), and its elements inherit
+// that level. Stability: for every set S and level k, fewer than 2^(k+1)
+// elements of S sit below level k. A violating set takes those elements over
+// and rises; sets that drop under 2^lev fall. These are the greedy choices up
+// to a factor 2, so the cover stays within O(log n) of optimal, and each
+// update costs amortized O(f log n) bucket moves (f = element frequency).
+class DynamicSetCover {
+public:
+    // Seeds the structure with a static greedy cover of `initial`, which
+    // already satisfies the invariants. Ids of `initial` are kept.
+    explicit DynamicSetCover(const FlatSetCoverInstance& initial);
+
+    // A new element contained in the given sets; returns its id.
+    int insertElement(const vector<int>& covering_sets);
+    void deleteElement(int elem);
+
+    // A new set over existing elements; returns its id.
+    int insertSet(const vector<int>& elements);
+    void deleteSet(int set_id);
+
+    int coverSize() const { return cover_size; }
+    vector<int> coverSets() const;
+
+    // Live elements that no live set contains.
+    int uncoveredCount() const { return uncovered; }
+
+    // Total element reassignments so far (the recourse of the structure).
+    long long reassignments() const { return moves; }
+
+    // Current live instance; dead sets keep their id with an empty row.
+    FlatSetCoverInstance snapshot() const;
+
+    // Full O(total size) check of the cover and both invariants.
+    bool checkInvariants() const;
+
+private:
+    // Deleting a set or element unlinks its incidences from both lists and
+    // recycles their slots, so memory and scans follow the live instance
+    // rather than the update history.
+    struct Incidence {
+        int set_id;
+        int elem;
+        int pos;        // index inside bucket[set_id][level of elem]
+        int set_slot;   // index inside set_incs[set_id]
+        int elem_slot;  // index inside elem_incs[elem]
+    };
+
+    vector<Incidence> inc;
+    vector<int> free_incs;
+    vector<vector<int>> set_incs, elem_incs;
+    vector<vector<vector<int>>> bucket;  // [set][level] -> incidence ids
+
+    vector<char> set_alive, elem_alive;
+    vector<int> set_level;               // -1 when not in the cover
+    vector<vector<int>> members;         // A(S)
+    vector<int> owner, member_pos;       // per element, owner -1 = unassigned
+
+    vector<int> dirty;
+    vector<char> in_dirty;
+
+    int cover_size = 0;
+    int uncovered = 0;
+    long long moves = 0;
+
+    int newSet();
+    int newElement();
+    void addIncidence(int set_id, int elem);
+    void unlinkFromSet(int id);
+    void unlinkFromElement(int id);
+
+    int level(int elem) const { return owner[elem] < 0 ? -1 : set_level[owner[elem]]; }
+    void markDirty(int set_id);
+    void bucketInsert(int id, int lvl);
+    void bucketErase(int id, int lvl);
+    void moveLevel(int elem, int old_level, int new_level);
+
+    void attach(int elem, int set_id);
+    void detach(int elem);
+    void placeOrphan(int elem);
+    void fall(int set_id);
+    void rise(int set_id, int k);
+    int violatedLevel(int set_id) const;
+    void stabilize();
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include "engines.h"
+#include "portfolio_solver.h"
+
+namespace {
+
+class GreedyEngine : public SetCoverEngine {
+    SetCoverSolver solver;
+
+public:
+    GreedyEngine(const FlatSetCoverInstance& flat, pmr::memory_resource* mem)
+        : solver(toSetCoverInstance(flat, mem)) {}
+
+    SetCoverSolution solve() override { return solver.solveGreedy(); }
+};
+
+class LazyGreedyEngine : public SetCoverEngine {
+    FlatSetCoverSolver solver;
+
+public:
+    LazyGreedyEngine(const FlatSetCoverInstance& flat, pmr::memory_resource* mem)
+        : solver(flat, mem) {}
+
+    SetCoverSolution solve() override { return solver.solveLazyGreedy(); }
+};
+
+class WeightedGreedyEngine : public SetCoverEngine {
+    FlatSetCoverSolver solver;
+
+public:
+    WeightedGreedyEngine(const FlatSetCoverInstance& flat, pmr::memory_resource* mem)
+        : solver(flat, mem) {}
+
+    SetCoverSolution solve() override { return solver.solveWeightedGreedy(); }
+};
+
+class PrimalDualEngine : public SetCoverEngine {
+    FlatSetCoverSolver solver;
+
+public:
+    PrimalDualEngine(const FlatSetCoverInstance& flat, pmr::memory_resource* mem)
+        : solver(flat, mem) {}
+
+    SetCoverSolution solve() override { return solver.solvePrimalDual(); }
+};
+
+class PortfolioEngine : public SetCoverEngine {
+    PortfolioSolver solver;
+
+public:
+    PortfolioEngine(const FlatSetCoverInstance& flat, pmr::memory_resource* mem,
+                    const EngineOptions& engine_opts)
+        : solver(flat, options(engine_opts), mem) {}
+
+    static PortfolioOptions options(const EngineOptions& engine_opts) {
+        PortfolioOptions opts;
+        opts.n_threads = engine_opts.n_threads;
+        opts.time_budget_ms = engine_opts.time_budget_ms;
+        return opts;
+    }
+
+    SetCoverSolution solve() override { return solver.solve(); }
+};
+
+}  // namespace
+
+const vector<string>& setCoverEngineNames() {
+    static const vector<string> names = {"greedy", "lazy", "weighted", "primal-dual", "portfolio"};
+    return names;
+}
+
+unique_ptr<SetCoverEngine> makeSetCoverEngine(const string& name,
+                                              const FlatSetCoverInstance& flat,
+                                              pmr::memory_resource* mem,
+                                              const EngineOptions& opts) {
+    if (name == "greedy") return make_unique<GreedyEngine>(flat, mem);
+    if (name == "lazy") return make_unique<LazyGreedyEngine>(flat, mem);
+    if (name == "weighted") return make_unique<WeightedGreedyEngine>(flat, mem);
+    if (name == "primal-dual") return make_unique<PrimalDualEngine>(flat, mem);
+    if (name == "portfolio") return make_unique<PortfolioEngine>(flat, mem, opts);
+    throw invalid_argument("unknown set cover engine: " + name);
+}
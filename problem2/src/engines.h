@@ -0,0 +1,29 @@
+#ifndef ENGINES_H
+#define ENGINES_H
+
+#include "set_cover_solver.h"
+
+// A solver prepared once for an instance and solved any number of times, so
+// drivers can time repeated solves and select engines by name at run time.
+class SetCoverEngine {
+public:
+    virtual ~SetCoverEngine() = default;
+    virtual SetCoverSolution solve() = 0;
+};
+
+// Settings for the parallel engines; the others ignore them.
+struct EngineOptions {
+    int n_threads = 0;          // 0 = all hardware threads; 1 when already one solve per core
+    double time_budget_ms = 0;  // portfolio wall-clock budget, 0 = none
+};
+
+const vector<string>& setCoverEngineNames();
+
+// Throws invalid_argument for unknown names. The instance must outlive the
+// returned engine; engine state and solutions are allocated from `mem`.
+unique_ptr<SetCoverEngine> makeSetCoverEngine(const string& name,
+                                              const FlatSetCoverInstance& flat,
+                                              pmr::memory_resource* mem = pmr::get_default_resource(),
+                                              const EngineOptions& opts = EngineOptions());
+
+#endif
@@ -2,9 +2,122 @@
 #include "set_cover_solver.h"
 #include "generators.h"
 #include "sat_reduction.h"
+#include "dimacs.h"
+#include "instance_io.h"
+#include "engines.h"
+#include "result_cache.h"
 using namespace std;
 
-int main() {
+// Pushes a DIMACS file through ingest and reduction, reporting each stage.
+int reduceCnfFile(const string& path) {
+    auto t0 = chrono::steady_clock::now();
+    FlatCnfFormula formula = readDimacsCnf(path);
+    auto t1 = chrono::steady_clock::now();
+    FlatSetCoverInstance flat = reduceCnfToSetCover(formula);
+    auto t2 = chrono::steady_clock::now();
+
+    auto ms = [](auto a, auto b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+
+    cout << "Variables,Clauses,Elements,Sets,SetEntries,Parse(ms),Reduce(ms)\n";
+    cout << formula.n_variables << "," << formula.n_clauses << ","
+         << flat.n_elements << "," << flat.n_sets << "," << flat.elements.size()
+         << "," << fixed << setprecision(3) << ms(t0, t1) << "," << ms(t1, t2) << "\n";
+    return 0;
+}
+
+// Writes a generated (optionally weighted) instance in the binary format.
+int generateInstanceFile(char** args) {
+    GeneratorOptions options;
+    string weights = args[4];
+    if (weights == "uniform") options.weights = SetWeights::Uniform;
+    else if (weights == "scaled") options.weights = SetWeights::SizeScaled;
+    else if (weights != "unit") throw invalid_argument("unknown weight model: " + weights);
+
+    FlatSetCoverInstance flat = generateFlatSetCover(stoi(args[0]), stoi(args[1]),
+                                                     stod(args[2]), stoull(args[3]), options);
+    writeSetCoverBinary(args[5], flat);
+    cout << flat.n_elements << " elements, " << flat.n_sets << " sets, "
+         << flat.elements.size() << " entries -> " << args[5] << "\n";
+    return 0;
+}
+
+// Generates many small instances for every distribution, including cluster
+// counts that do not divide n, and checks each one's structure and coverage.
+int checkGenerators() {
+    const SetDistribution distributions[] = {
+        SetDistribution::Uniform, SetDistribution::Zipf, SetDistribution::Clustered};
+    long long checked = 0;
+    for (SetDistribution dist : distributions)
+        for (int clusters : {16, 5})
+            for (int n = 1; n <= 40; n++)
+                for (int m : {1, 3, 20})
+                    for (double density : {0.05, 0.3, 0.9})
+                        for (uint64_t seed = 1; seed <= 3; seed++) {
+                            GeneratorOptions options;
+                            options.distribution = dist;
+                            options.weights = SetWeights::Uniform;
+                            options.n_clusters = clusters;
+                            FlatSetCoverInstance flat =
+                                generateFlatSetCover(n, m, density, seed, options);
+                            checkStructure(flat);
+                            checkWeights(flat);
+                            vector<char> covered(n, 0);
+                            for (int elem : flat.elements) covered[elem] = 1;
+                            if (count(covered.begin(), covered.end(), 0))
+                                throw runtime_error("generated instance leaves an element uncovered");
+                            checked++;
+                        }
+    cout << checked << " generated instances ok\n";
+    return 0;
+}
+
+// Loads a binary instance and solves it with the named engine.
+int solveInstanceFile(const string& path, const string& engine_name, double budget_ms) {
+    auto t0 = chrono::steady_clock::now();
+    FlatSetCoverInstance flat = readSetCoverBinary(path);
+    auto t1 = chrono::steady_clock::now();
+    EngineOptions opts;
+    opts.time_budget_ms = budget_ms;
+    auto engine = makeSetCoverEngine(engine_name, flat, pmr::get_default_resource(), opts);
+    SetCoverSolution sol = engine->solve();
+
+    double lb = flat.weighted() ? FlatSetCoverSolver::calculateWeightedLowerBound(flat)
+                                : FlatSetCoverSolver::calculateLowerBound(flat);
+
+    cout << "Engine,Elements,Sets,Load(ms),Time(us),Cost,Weight,LowerBound,ApproxRatio\n";
+    cout << engine_name << "," << flat.n_elements << "," << flat.n_sets << ","
+         << fixed << setprecision(3) << chrono::duration<double, milli>(t1 - t0).count()
+         << "," << sol.execution_time_us << "," << sol.cost << "," << sol.total_weight
+         << "," << lb << "," << (lb > 0 ? sol.total_weight / lb : 0.0) << "\n";
+    return 0;
+}
+
+// Usage: setcover_experiments [--cnf file | --cache dir]
+//        setcover_experiments --generate n m density seed unit|uniform|scaled out.scb
+//        setcover_experiments --solve file.scb [engine [budget_ms]]
+//        setcover_experiments --check-generators
+int main(int argc, char** argv) {
+    unique_ptr<ResultCache> cache;
+    if (argc > 1) {
+        try {
+            string flag = argv[1];
+            if (flag == "--check-generators" && argc == 2) return checkGenerators();
+            if (flag == "--generate" && argc == 8) return generateInstanceFile(argv + 2);
+            if (flag == "--solve" && argc >= 3 && argc <= 5)
+                return solveInstanceFile(argv[2], argc >= 4 ? argv[3] : "weighted",
+                                         argc == 5 ? stod(argv[4]) : 0);
+            if (argc != 3) throw invalid_argument("bad arguments for " + flag);
+            if (flag == "--cnf") return reduceCnfFile(argv[2]);
+            if (flag != "--cache") throw invalid_argument("unknown flag " + flag);
+            cache = make_unique<ResultCache>(argv[2]);
+        } catch (const exception& e) {
+            cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
     cout << "=============================================================\n";
     cout << "    PROBLEM 2: SET COVER - NP-COMPLETENESS & GREEDY\n";
     cout << "=============================================================\n";
@@ -26,6 +139,7 @@ int main() {
         auto inst = generateRandomSetCover(n, m, 0.4);
 
         SetCoverSolver solver(inst);
+        solver.setResultCache(cache.get());
         auto sol = solver.solveGreedy();
         int lb = solver.calculateLowerBound(inst);
 
@@ -36,5 +150,12 @@ int main() {
              << ratio << "\n";
     }
 
+    if (cache) {
+        CacheStats s = cache->stats();
+        cerr << "cache: " << s.hits << " hits, " << s.misses << " misses, "
+             << s.stores << " stores, " << s.evictions << " evictions, "
+             << s.failed_stores << " failed stores\n";
+    }
+
     return 0;
 }
@@ -1,53 +1,271 @@
 #include "generators.h"
+#include "parallel.h"
 
-SetCoverInstance generateRandomSetCover(int n_elements, int n_sets,
-                                        double density, int seed) {
-    SetCoverInstance instance;
-    instance.n_elements = n_elements;
-    instance.n_sets = n_sets;
-    instance.sets.resize(n_sets);
-
-    mt19937 rng(seed);
-    bernoulli_distribution dist(density);
-
-    for (int i = 0; i < n_sets; i++)
-        for (int j = 0; j < n_elements; j++)
-            if (dist(rng))
-                instance.sets[i].insert(j), instance.universe.insert(j);
-
-    for (int elem = 0; elem < n_elements; elem++) {
-        bool found = false;
-        for (const auto& s : instance.sets)
-            if (s.count(elem)) found = true;
-
-        if (!found) {
-            int random_set = rng() % n_sets;
-            instance.sets[random_set].insert(elem);
-        }
-        instance.universe.insert(elem);
+namespace {
+
+const uint64_t kGolden = 0x9e3779b97f4a7c15ULL;
+const uint64_t kFixupSalt = 0x5bd1e9955bd1e995ULL;
+const uint64_t kWeightSalt = 0xc6a4a7935bd1e995ULL;
+const long long kSetsPerChunk = 64;
+const long long kClausesPerChunk = 1 << 14;
+
+uint64_t mix64(uint64_t x) {
+    x += kGolden;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// The k-th draw of stream `id` is mix64(key + k * golden): a pure function of
+// (seed, id, k), which is what makes the parallel build reproducible.
+struct StreamRng {
+    uint64_t key;
+    uint64_t counter = 0;
+
+    StreamRng(uint64_t seed, uint64_t id) : key(mix64(seed ^ mix64(id))) {}
+
+    uint64_t next() { return mix64(key + (counter++) * kGolden); }
+
+    // Uniform on the open interval (0, 1), safe to pass to log().
+    double uniform() { return ((next() >> 11) + 0.5) * 0x1.0p-53; }
+
+    uint32_t bounded(uint32_t n) {
+        return (uint32_t)(((next() >> 32) * n) >> 32);
+    }
+};
+
+// Appends each position of [begin, end) independently with probability p.
+// Gaps between hits are geometric, so we jump straight from hit to hit.
+void sampleRange(StreamRng& rng, int begin, int end, double p, vector<int>& out) {
+    if (p <= 0 || begin >= end) return;
+    if (p >= 1) {
+        for (int j = begin; j < end; j++) out.push_back(j);
+        return;
     }
 
-    return instance;
+    double log_q = log1p(-p);
+    long long pos = (long long)begin - 1;
+    while (true) {
+        double skip = floor(log(rng.uniform()) / log_q);
+        if (skip >= (double)(end - pos - 1)) break;
+        pos += 1 + (long long)skip;
+        out.push_back((int)pos);
+    }
 }
 
-ThreeSATFormula generateRandom3SAT(int n_variables, int n_clauses, int seed) {
-    ThreeSATFormula formula;
-    formula.n_variables = n_variables;
-    formula.n_clauses = n_clauses;
-    formula.clauses.resize(n_clauses);
-
-    mt19937 rng(seed);
-    uniform_int_distribution<> var_dist(1, n_variables);
-    bernoulli_distribution sign_dist(0.5);
-
-    for (int i = 0; i < n_clauses; i++) {
-        set<int> vars;
-        while (vars.size() < 3)
-            vars.insert(var_dist(rng));
-
-        for (int v : vars)
-            formula.clauses[i].push_back(sign_dist(rng) ? v : -v);
+// Inclusion probabilities min(1, c * (j+1)^-s), with c chosen by bisection so
+// the expected set size matches the uniform generator at the same density.
+vector<double> zipfProbabilities(int n_elements, double density, double exponent) {
+    vector<double> weight(n_elements);
+    for (int j = 0; j < n_elements; j++)
+        weight[j] = pow(j + 1.0, -exponent);
+
+    double target = density * n_elements;
+    double lo = 0, hi = pow((double)max(1, n_elements), exponent);
+    for (int iter = 0; iter < 60; iter++) {
+        double mid = (lo + hi) / 2, total = 0;
+        for (double w : weight) total += min(1.0, mid * w);
+        (total < target ? lo : hi) = mid;
     }
 
-    return formula;
+    for (double& w : weight) w = min(1.0, hi * w);
+    return weight;
+}
+
+// Probabilities are non-increasing in j, so inside the doubling block
+// [a, 2a+1) we sample at prob[a] and thin by prob[j] / prob[a]. The thinning
+// rejects at most a 1 - 2^-s fraction of candidates.
+void sampleZipf(StreamRng& rng, const vector<double>& prob, vector<int>& out) {
+    int n = prob.size();
+    for (int a = 0; a < n; a = 2 * a + 1) {
+        int b = min(n, 2 * a + 1);
+        size_t first = out.size(), kept = first;
+        sampleRange(rng, a, b, prob[a], out);
+
+        for (size_t k = first; k < out.size(); k++)
+            if (prob[out[k]] >= prob[a] || rng.uniform() * prob[a] < prob[out[k]])
+                out[kept++] = out[k];
+        out.resize(kept);
+    }
+}
+
+void sampleClustered(StreamRng& rng, int n_elements, double density,
+                     const GeneratorOptions& options, vector<int>& out) {
+    // Balanced bounds: rounding the cluster size up would leave the last
+    // clusters starting past n_elements whenever n_clusters does not divide it.
+    int n_clusters = max(1, min(options.n_clusters, n_elements));
+    int home = rng.bounded(n_clusters);
+    int a = (long long)home * n_elements / n_clusters;
+    int b = (long long)(home + 1) * n_elements / n_clusters;
+
+    double target = density * n_elements;
+    int inside = b - a, outside = n_elements - inside;
+    double p_in = min(1.0, options.cluster_locality * target / max(1, inside));
+    double p_out = outside > 0
+        ? clamp((target - p_in * inside) / outside, 0.0, 1.0) : 0.0;
+
+    sampleRange(rng, 0, a, p_out, out);
+    sampleRange(rng, a, b, p_in, out);
+    sampleRange(rng, b, n_elements, p_out, out);
+}
+
+// Every element must be coverable. Orphans are handed to a set picked from
+// the element's own stream, then merged into that set's sorted row.
+void coverOrphans(FlatSetCoverInstance& flat, uint64_t seed, int n_threads) {
+    if (flat.n_sets == 0) return;
+
+    unique_ptr<atomic<unsigned char>[]> covered(
+        new atomic<unsigned char>[flat.n_elements]());
+    parallelFor(flat.elements.size(), 1 << 16, n_threads,
+        [&](long long begin, long long end) {
+            for (long long k = begin; k < end; k++)
+                covered[flat.elements[k]].store(1, memory_order_relaxed);
+        });
+
+    vector<pair<int, int>> orphans;
+    for (int elem = 0; elem < flat.n_elements; elem++)
+        if (!covered[elem].load(memory_order_relaxed))
+            orphans.push_back({(int)StreamRng(seed ^ kFixupSalt, elem).bounded(flat.n_sets), elem});
+    if (orphans.empty()) return;
+
+    sort(orphans.begin(), orphans.end());
+
+    vector<long long> offsets(flat.n_sets + 1, 0);
+    vector<int> elements;
+    elements.reserve(flat.elements.size() + orphans.size());
+
+    size_t next = 0;
+    for (int i = 0; i < flat.n_sets; i++) {
+        auto row_begin = flat.elements.begin() + flat.offsets[i];
+        auto row_end = flat.elements.begin() + flat.offsets[i + 1];
+        size_t extra = next;
+        while (extra < orphans.size() && orphans[extra].first == i) extra++;
+
+        vector<int> added;
+        for (size_t k = next; k < extra; k++) added.push_back(orphans[k].second);
+        merge(row_begin, row_end, added.begin(), added.end(), back_inserter(elements));
+
+        next = extra;
+        offsets[i + 1] = elements.size();
+    }
+
+    flat.offsets = move(offsets);
+    flat.elements = move(elements);
+}
+
+// Weights come from their own streams, so the rows are the same whatever
+// weight model is chosen.
+void assignWeights(FlatSetCoverInstance& flat, uint64_t seed, const GeneratorOptions& options) {
+    if (options.weights == SetWeights::Unit) return;
+    if (!(options.min_weight >= 0) || !(options.max_weight >= options.min_weight))
+        throw invalid_argument("need 0 <= min_weight <= max_weight");
+
+    flat.weights.resize(flat.n_sets);
+    double span = options.max_weight - options.min_weight;
+    parallelFor(flat.n_sets, 1 << 12, options.n_threads,
+        [&](long long begin, long long end) {
+            for (long long i = begin; i < end; i++) {
+                double w = options.min_weight + span * StreamRng(seed ^ kWeightSalt, i).uniform();
+                if (options.weights == SetWeights::SizeScaled && options.max_weight > 0)
+                    w *= (flat.offsets[i + 1] - flat.offsets[i]) / options.max_weight;
+                flat.weights[i] = w;
+            }
+        });
+}
+
+}  // namespace
+
+FlatSetCoverInstance generateFlatSetCover(int n_elements, int n_sets,
+                                          double density, uint64_t seed,
+                                          const GeneratorOptions& options) {
+    FlatSetCoverInstance flat;
+    flat.n_elements = n_elements;
+    flat.n_sets = n_sets;
+    flat.offsets.assign(n_sets + 1, 0);
+
+    vector<double> zipf_prob;
+    if (options.distribution == SetDistribution::Zipf)
+        zipf_prob = zipfProbabilities(n_elements, density, options.zipf_exponent);
+
+    // Pass 1: each chunk of sets is sampled into its own buffer.
+    long long n_chunks = (n_sets + kSetsPerChunk - 1) / kSetsPerChunk;
+    vector<vector<int>> chunk_rows(n_chunks);
+
+    parallelFor(n_sets, kSetsPerChunk, options.n_threads,
+        [&](long long begin, long long end) {
+            vector<int>& rows = chunk_rows[begin / kSetsPerChunk];
+            for (long long i = begin; i < end; i++) {
+                StreamRng rng(seed, i);
+                size_t before = rows.size();
+
+                switch (options.distribution) {
+                case SetDistribution::Uniform:
+                    sampleRange(rng, 0, n_elements, density, rows);
+                    break;
+                case SetDistribution::Zipf:
+                    sampleZipf(rng, zipf_prob, rows);
+                    break;
+                case SetDistribution::Clustered:
+                    sampleClustered(rng, n_elements, density, options, rows);
+                    break;
+                }
+
+                flat.offsets[i + 1] = rows.size() - before;
+            }
+        });
+
+    // Pass 2: prefix-sum the row sizes, then copy every chunk into place.
+    partial_sum(flat.offsets.begin(), flat.offsets.end(), flat.offsets.begin());
+    flat.elements.resize(flat.offsets[n_sets]);
+
+    parallelFor(n_chunks, 1, options.n_threads,
+        [&](long long begin, long long end) {
+            for (long long c = begin; c < end; c++) {
+                copy(chunk_rows[c].begin(), chunk_rows[c].end(),
+                     flat.elements.begin() + flat.offsets[c * kSetsPerChunk]);
+                vector<int>().swap(chunk_rows[c]);
+            }
+        });
+
+    coverOrphans(flat, seed, options.n_threads);
+    assignWeights(flat, seed, options);
+    return flat;
+}
+
+FlatCnfFormula generateFlat3SAT(int n_variables, int n_clauses,
+                                uint64_t seed, int n_threads) {
+    FlatCnfFormula flat;
+    flat.n_variables = n_variables;
+    flat.n_clauses = n_clauses;
+    flat.offsets.resize(n_clauses + 1);
+    flat.literals.resize(3LL * n_clauses);
+
+    parallelFor(n_clauses, kClausesPerChunk, n_threads,
+        [&](long long begin, long long end) {
+            for (long long c = begin; c < end; c++) {
+                StreamRng rng(seed, c);
+
+                int v[3];
+                v[0] = 1 + rng.bounded(n_variables);
+                do v[1] = 1 + rng.bounded(n_variables); while (v[1] == v[0]);
+                do v[2] = 1 + rng.bounded(n_variables); while (v[2] == v[0] || v[2] == v[1]);
+                sort(v, v + 3);
+
+                uint64_t signs = rng.next();
+                for (int k = 0; k < 3; k++)
+                    flat.literals[3 * c + k] = (signs >> k & 1) ? v[k] : -v[k];
+                flat.offsets[c + 1] = 3 * (c + 1);
+            }
+        });
+
+    return flat;
+}
+
+SetCoverInstance generateRandomSetCover(int n_elements, int n_sets,
+                                        double density, int seed) {
+    return toSetCoverInstance(generateFlatSetCover(n_elements, n_sets, density, seed));
+}
+
+ThreeSATFormula generateRandom3SAT(int n_variables, int n_clauses, int seed) {
+    return toThreeSATFormula(generateFlat3SAT(n_variables, n_clauses, seed));
 }
@@ -4,6 +4,39 @@
 #include "set_cover_instance.h"
 #include "sat_reduction.h"
 
+enum class SetDistribution {
+    Uniform,    // every (set, element) pair is included with probability density
+    Zipf,       // element j is included with probability proportional to (j+1)^-s
+    Clustered   // each set draws most of its elements from one home cluster
+};
+
+enum class SetWeights {
+    Unit,       // no weights: every set costs 1
+    Uniform,    // weight drawn uniformly from [min_weight, max_weight]
+    SizeScaled  // |S| times a uniform factor from [min_weight, max_weight] / max_weight
+};
+
+struct GeneratorOptions {
+    SetDistribution distribution = SetDistribution::Uniform;
+    SetWeights weights = SetWeights::Unit;
+    double min_weight = 1.0;
+    double max_weight = 100.0;
+    double zipf_exponent = 1.0;
+    int n_clusters = 16;
+    double cluster_locality = 0.8;  // expected share of a set inside its cluster
+    int n_threads = 0;              // 0 = all hardware threads
+};
+
+// Every generator below draws set i (or clause i) from its own counter-based
+// random stream, so the output depends only on the arguments and seed, never
+// on the thread count. Expected cost is proportional to the output size.
+FlatSetCoverInstance generateFlatSetCover(int n_elements, int n_sets,
+                                          double density, uint64_t seed,
+                                          const GeneratorOptions& options = GeneratorOptions());
+
+FlatCnfFormula generateFlat3SAT(int n_variables, int n_clauses,
+                                uint64_t seed, int n_threads = 0);
+
 SetCoverInstance generateRandomSetCover(int n_elements, int n_sets,
                                         double density = 0.3, int seed = 42);
 
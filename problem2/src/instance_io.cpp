@@ -0,0 +1,87 @@
+#include "instance_io.h"
+
+namespace {
+
+const char kMagic[4] = {'S', 'C', 'B', '1'};
+const int kWeightedFlag = 1;
+
+// Checks `count` against the bytes left in the file before sizing anything,
+// so a corrupt header fails as a truncated file rather than a huge allocation.
+template <class T>
+void readArray(ifstream& in, vector<T>& out, long long count, long long file_size,
+               const string& path) {
+    long long left = file_size - (long long)in.tellg();
+    if (count > left / (long long)sizeof(T))
+        throw runtime_error("truncated set cover file " + path);
+    out.resize(count);
+    if (!in.read(reinterpret_cast<char*>(out.data()), count * sizeof(T)))
+        throw runtime_error("truncated set cover file " + path);
+}
+
+template <class T>
+void writeArray(ofstream& out, const vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+}  // namespace
+
+FlatSetCoverInstance readSetCoverBinary(const string& path) {
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) throw runtime_error("cannot open " + path);
+    long long file_size = in.tellg();
+    in.seekg(0);
+
+    char magic[4];
+    int32_t header[3];
+    int64_t n_entries;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    in.read(reinterpret_cast<char*>(&n_entries), sizeof(n_entries));
+    if (!in || memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        throw runtime_error("not a set cover binary file: " + path);
+
+    FlatSetCoverInstance flat;
+    flat.n_elements = header[0];
+    flat.n_sets = header[1];
+    if (flat.n_elements < 0 || flat.n_sets < 0 || n_entries < 0)
+        throw runtime_error("bad set cover header in " + path);
+
+    readArray(in, flat.offsets, flat.n_sets + 1LL, file_size, path);
+    if (flat.offsets[0] != 0 || flat.offsets[flat.n_sets] != n_entries)
+        throw runtime_error("bad set offsets in " + path);
+    for (int i = 0; i < flat.n_sets; i++)
+        if (flat.offsets[i] > flat.offsets[i + 1])
+            throw runtime_error("bad set offsets in " + path);
+
+    readArray(in, flat.elements, n_entries, file_size, path);
+    for (int i = 0; i < flat.n_sets; i++)
+        for (long long k = flat.offsets[i]; k < flat.offsets[i + 1]; k++) {
+            int elem = flat.elements[k];
+            if (elem < 0 || elem >= flat.n_elements)
+                throw runtime_error("element out of range in " + path);
+            if (k > flat.offsets[i] && elem <= flat.elements[k - 1])
+                throw runtime_error("set rows must be strictly ascending in " + path);
+        }
+
+    if (header[2] & kWeightedFlag) {
+        readArray(in, flat.weights, flat.n_sets, file_size, path);
+        checkWeights(flat);
+    }
+    return flat;
+}
+
+void writeSetCoverBinary(const string& path, const FlatSetCoverInstance& flat) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("cannot write " + path);
+
+    int32_t header[3] = {flat.n_elements, flat.n_sets, flat.weighted() ? kWeightedFlag : 0};
+    int64_t n_entries = flat.elements.size();
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(&n_entries), sizeof(n_entries));
+    writeArray(out, flat.offsets);
+    writeArray(out, flat.elements);
+    if (flat.weighted()) writeArray(out, flat.weights);
+
+    if (!out.flush()) throw runtime_error("cannot write " + path);
+}
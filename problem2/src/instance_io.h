@@ -0,0 +1,16 @@
+#ifndef INSTANCE_IO_H
+#define INSTANCE_IO_H
+
+#include "set_cover_instance.h"
+
+// Binary set cover instance (.scb), host byte order:
+//   char[4] "SCB1", int32 n_elements, int32 n_sets, int32 flags (bit 0 =
+//   weighted), int64 n_entries, int64 offsets[n_sets + 1],
+//   int32 elements[n_entries], then double weights[n_sets] if weighted.
+// The arrays are the FlatSetCoverInstance vectors verbatim, so reading is a
+// handful of bulk reads. Throws runtime_error on malformed files.
+FlatSetCoverInstance readSetCoverBinary(const string& path);
+
+void writeSetCoverBinary(const string& path, const FlatSetCoverInstance& flat);
+
+#endif
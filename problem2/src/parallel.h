@@ -0,0 +1,41 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// 0 (or any non-positive value) means "use every hardware thread".
+inline int resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+    int hw = (int)thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// Runs body(begin, end) over [0, n) in chunks of `grain` indices. Workers
+// claim chunks dynamically, so skewed per-index costs still balance; chunk
+// boundaries depend only on n and grain, never on the thread count.
+template <class Body>
+void parallelFor(long long n, long long grain, int n_threads, Body body) {
+    if (n <= 0) return;
+    grain = max(1LL, grain);
+    long long n_chunks = (n + grain - 1) / grain;
+    int workers = (int)min<long long>(resolveThreadCount(n_threads), n_chunks);
+
+    atomic<long long> next_chunk(0);
+    auto worker = [&]() {
+        for (long long c; (c = next_chunk.fetch_add(1)) < n_chunks;)
+            body(c * grain, min(n, (c + 1) * grain));
+    };
+
+    if (workers <= 1) {
+        worker();
+        return;
+    }
+
+    vector<thread> pool;
+    for (int t = 1; t < workers; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "portfolio_solver.h"
+#include "parallel.h"
+#include "trace.h"
+
+namespace {
+
+enum class RunOutcome { Completed, Pruned, TimedOut, Skipped };
+
+struct RunRecord {
+    RunOutcome outcome = RunOutcome::Skipped;
+};
+
+}  // namespace
+
+PortfolioSolver::PortfolioSolver(const FlatSetCoverInstance& inst,
+                                 const PortfolioOptions& opts,
+                                 pmr::memory_resource* mem_in)
+    : instance(inst), options(opts), mem(mem_in) {}
+
+SetCoverSolution PortfolioSolver::solve() {
+    auto start = chrono::high_resolution_clock::now();
+    TraceProbe probe("portfolio");
+    checkWeights(instance);
+
+    int n_runs = max(1, options.n_runs);
+    auto deadline = chrono::steady_clock::now() +
+        chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double, milli>(options.time_budget_ms));
+    bool has_deadline = options.time_budget_ms > 0;
+
+    // Only elements some set contains can (and must) be covered.
+    vector<char> coverable(instance.n_elements, 0);
+    for (int elem : instance.elements) coverable[elem] = 1;
+    long long n_coverable = count(coverable.begin(), coverable.end(), 1);
+    probe.phase("setup");
+
+    // Cover weight; the cover size on unweighted instances.
+    atomic<double> best_cost(numeric_limits<double>::infinity());
+    mutex best_mutex;
+    vector<int> best_sets;
+    int best_run = -1;
+    vector<RunRecord> records(n_runs);
+
+    // Traced runs record into their own trace on whichever thread runs
+    // them; the winner's iterations become this solve's iterations.
+    bool tracing = kTraceCompiledIn && activeTrace() != nullptr;
+    vector<SolverTrace> run_traces(tracing ? n_runs : 0);
+    vector<long long> run_origins(tracing ? n_runs : 0);
+
+    auto run = [&](int r) {
+        RunRecord& rec = records[r];
+        optional<ScopedTrace> scope;
+        if (tracing) scope.emplace(run_traces[r]);
+        TraceProbe run_probe("portfolio");
+        if (tracing) run_origins[r] = run_probe.originNs();
+        long long evaluated = 0, touched = 0;
+        mt19937_64 rng(options.seed ^ (0x9e3779b97f4a7c15ULL * (r + 1)));
+        uniform_real_distribution<double> unit(-1.0, 1.0);
+
+        double noise = r % 2 == 1 ? clamp(options.noise, 0.0, 0.9) : 0.0;
+        vector<double> scale(instance.n_sets, 1.0);
+        vector<uint32_t> rank(instance.n_sets);
+        for (int i = 0; i < instance.n_sets; i++) {
+            rank[i] = r == 0 ? (uint32_t)(instance.n_sets - i) : (uint32_t)rng();
+            if (noise > 0) scale[i] = 1.0 + noise * unit(rng);
+        }
+
+        // Keys are perturbed gains per unit weight, so a stale key still
+        // bounds the current one from above and the lazy re-evaluation stays
+        // valid.
+        auto keyOf = [&](long long gain, int i) {
+            double w = instance.weight(i);
+            return w > 0 ? gain * scale[i] / w : numeric_limits<double>::infinity();
+        };
+        priority_queue<tuple<double, uint32_t, int>> heap;
+        for (int i = 0; i < instance.n_sets; i++) {
+            long long size = instance.offsets[i + 1] - instance.offsets[i];
+            if (size > 0) heap.push({keyOf(size, i), rank[i], i});
+        }
+
+        vector<char> covered(instance.n_elements, 0);
+        vector<int> selected;
+        double spent = 0;
+        long long remaining = n_coverable;
+
+        while (remaining > 0 && !heap.empty()) {
+            if (r != 0 && has_deadline && chrono::steady_clock::now() > deadline) {
+                rec.outcome = RunOutcome::TimedOut;
+                return;
+            }
+
+            // No set covers more than max_key elements per unit weight, so
+            // the rest costs at least remaining / max_key (a whole number of
+            // sets when unweighted). Only a strictly worse bound prunes: a
+            // run that could tie must finish so the lowest index wins, and
+            // the margin keeps rounding in the weighted sums from deciding.
+            double max_key = get<0>(heap.top()) / (1.0 - noise);
+            double needed = remaining / max_key;
+            if (!instance.weighted()) needed = ceil(needed - 1e-9);
+            double best = best_cost.load(memory_order_relaxed);
+            if (spent + needed > best + 1e-9 * best) {
+                rec.outcome = RunOutcome::Pruned;
+                return;
+            }
+
+            auto [key, tiebreak, i] = heap.top();
+            heap.pop();
+            long long size = instance.offsets[i + 1] - instance.offsets[i];
+            evaluated++;
+            touched += size;
+
+            int gain = 0;
+            for (long long k = instance.offsets[i]; k < instance.offsets[i + 1]; k++)
+                if (!covered[instance.elements[k]]) gain++;
+
+            if (gain == 0) continue;
+            double current = keyOf(gain, i);
+            if (current < key) {
+                heap.push({current, tiebreak, i});
+                continue;
+            }
+
+            run_probe.phase("scan");
+
+            for (long long k = instance.offsets[i]; k < instance.offsets[i + 1]; k++)
+                covered[instance.elements[k]] = 1;
+            remaining -= gain;
+            run_probe.phase("update");
+
+            selected.push_back(i);
+            spent += instance.weight(i);
+            run_probe.phase("record");
+
+            run_probe.endIteration(i, gain, evaluated, touched + size);
+            evaluated = touched = 0;
+        }
+        run_probe.phase("scan");
+
+        rec.outcome = RunOutcome::Completed;
+
+        lock_guard<mutex> lock(best_mutex);
+        if (spent < best_cost.load() || (spent == best_cost.load() && r < best_run)) {
+            best_sets = move(selected);
+            best_run = r;
+            best_cost.store(spent);
+        }
+    };
+
+    // Runs are claimed in index order, so run 0 always starts first.
+    parallelFor(n_runs, 1, options.n_threads, [&](long long begin, long long end) {
+        for (long long r = begin; r < end; r++) {
+            if (r != 0 && has_deadline && chrono::steady_clock::now() > deadline) continue;
+            run(r);
+        }
+    });
+    if (tracing && best_run >= 0) probe.absorb(run_traces[best_run], run_origins[best_run]);
+
+    last_stats = {0, 0, 0, 0, best_run};
+    for (int r = 0; r < n_runs; r++) {
+        const RunRecord& rec = records[r];
+        last_stats.runs_started += rec.outcome != RunOutcome::Skipped;
+        last_stats.runs_completed += rec.outcome == RunOutcome::Completed;
+        last_stats.runs_pruned += rec.outcome == RunOutcome::Pruned;
+        last_stats.runs_timed_out += rec.outcome != RunOutcome::Completed &&
+                                     rec.outcome != RunOutcome::Pruned;
+    }
+
+    SetCoverSolution solution(mem);
+    vector<char> covered(instance.n_elements, 0);
+    for (int s : best_sets) {
+        solution.selected_sets.push_back(s);
+        for (long long k = instance.offsets[s]; k < instance.offsets[s + 1]; k++)
+            covered[instance.elements[k]] = 1;
+    }
+    for (int elem = 0; elem < instance.n_elements; elem++)
+        if (covered[elem])
+            solution.covered_elements.insert(solution.covered_elements.end(), elem);
+    probe.phase("finalize");
+
+    solution.cost = solution.selected_sets.size();
+    solution.total_weight = totalWeight(instance, solution.selected_sets);
+    auto end = chrono::high_resolution_clock::now();
+    solution.execution_time_us =
+        chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    return solution;
+}
@@ -0,0 +1,47 @@
+#ifndef PORTFOLIO_SOLVER_H
+#define PORTFOLIO_SOLVER_H
+
+#include "set_cover_instance.h"
+
+struct PortfolioOptions {
+    int n_runs = 16;
+    int n_threads = 0;            // 0 = all hardware threads
+    double time_budget_ms = 0;    // 0 = no limit; run 0 always finishes
+    double noise = 0.1;           // odd runs scale set gains by 1 +- noise
+    uint64_t seed = 1;
+};
+
+struct PortfolioStats {
+    int runs_started;
+    int runs_completed;
+    int runs_pruned;      // abandoned once they could no longer beat the best
+    int runs_timed_out;
+    int best_run;
+};
+
+// Best-of-N randomized greedy. Run 0 is the deterministic lazy greedy; even
+// runs break ties at random and odd runs also perturb every set's gain per
+// unit weight by a fixed random factor. Runs share the instance read-only and
+// publish the lowest cover weight found so far (cover size when unweighted);
+// a run stops as soon as its weight plus a lower bound on the weight still
+// needed exceeds it. Runs that tie finish, and the lowest run index wins, so
+// without a time budget the cover depends only on the seed. The instance
+// must outlive the solver.
+class PortfolioSolver {
+private:
+    const FlatSetCoverInstance& instance;
+    PortfolioOptions options;
+    pmr::memory_resource* mem;
+    PortfolioStats last_stats = {0, 0, 0, 0, -1};
+
+public:
+    PortfolioSolver(const FlatSetCoverInstance& inst,
+                    const PortfolioOptions& opts = PortfolioOptions(),
+                    pmr::memory_resource* mem_in = pmr::get_default_resource());
+
+    SetCoverSolution solve();
+
+    const PortfolioStats& stats() const { return last_stats; }
+};
+
+#endif
@@ -1,13 +1,24 @@
 #include "sat_reduction.h"
+#include "parallel.h"
+
+// Two literal elements per variable plus one element per clause; element ids
+// are int, so formulas whose universe would not fit are rejected up front.
+static int reducedElementCount(int n_variables, int n_clauses) {
+    long long n_elements = 2LL * n_variables + n_clauses;
+    if (n_variables < 0 || n_clauses < 0 || n_elements > INT_MAX)
+        throw invalid_argument("formula too large to reduce: 2 * variables + clauses = " +
+                               to_string(n_elements) + " exceeds the element id range");
+    return (int)n_elements;
+}
 
 SetCoverInstance reduceThreeSATtoSetCover(const ThreeSATFormula& formula) {
     SetCoverInstance instance;
-    instance.n_elements = 2 * formula.n_variables + formula.n_clauses;
+    instance.n_elements = reducedElementCount(formula.n_variables, formula.n_clauses);
     instance.n_sets = formula.n_clauses;
     instance.sets.resize(instance.n_sets);
 
     for (int c = 0; c < formula.n_clauses; c++) {
-        set<int>& clause_set = instance.sets[c];
+        pmr::set<int>& clause_set = instance.sets[c];
         clause_set.insert(2 * formula.n_variables + c);
 
         for (int literal : formula.clauses[c]) {
@@ -24,3 +35,70 @@ SetCoverInstance reduceThreeSATtoSetCover(const ThreeSATFormula& formula) {
 
     return instance;
 }
+
+ThreeSATFormula toThreeSATFormula(const FlatCnfFormula& flat) {
+    ThreeSATFormula formula;
+    formula.n_variables = flat.n_variables;
+    formula.n_clauses = flat.n_clauses;
+    formula.clauses.resize(flat.n_clauses);
+
+    for (int c = 0; c < flat.n_clauses; c++)
+        formula.clauses[c].assign(flat.literals.begin() + flat.offsets[c],
+                                  flat.literals.begin() + flat.offsets[c + 1]);
+
+    return formula;
+}
+
+namespace {
+
+const long long kClausesPerChunk = 1 << 14;
+
+// Sorted, de-duplicated literal elements of clause c (2*var for x, 2*var+1
+// for NOT x); `scratch` is reused across clauses to avoid allocations.
+void literalElements(const FlatCnfFormula& formula, int c, vector<int>& scratch) {
+    scratch.clear();
+    for (long long k = formula.offsets[c]; k < formula.offsets[c + 1]; k++) {
+        int literal = formula.literals[k];
+        int var = abs(literal) - 1;
+        scratch.push_back(literal > 0 ? 2 * var : 2 * var + 1);
+    }
+    sort(scratch.begin(), scratch.end());
+    scratch.erase(unique(scratch.begin(), scratch.end()), scratch.end());
+}
+
+}  // namespace
+
+FlatSetCoverInstance reduceCnfToSetCover(const FlatCnfFormula& formula, int n_threads) {
+    FlatSetCoverInstance flat;
+    flat.n_elements = reducedElementCount(formula.n_variables, formula.n_clauses);
+    flat.n_sets = formula.n_clauses;
+    flat.offsets.assign(flat.n_sets + 1, 0);
+
+    // Pass 1: exact row sizes (distinct literals plus the clause element).
+    parallelFor(flat.n_sets, kClausesPerChunk, n_threads,
+        [&](long long begin, long long end) {
+            vector<int> scratch;
+            for (long long c = begin; c < end; c++) {
+                literalElements(formula, c, scratch);
+                flat.offsets[c + 1] = scratch.size() + 1;
+            }
+        });
+
+    partial_sum(flat.offsets.begin(), flat.offsets.end(), flat.offsets.begin());
+    flat.elements.resize(flat.offsets[flat.n_sets]);
+
+    // Pass 2: fill rows in place. Literal elements are all below 2n, so the
+    // clause element always goes last and the row stays sorted.
+    parallelFor(flat.n_sets, kClausesPerChunk, n_threads,
+        [&](long long begin, long long end) {
+            vector<int> scratch;
+            for (long long c = begin; c < end; c++) {
+                literalElements(formula, c, scratch);
+                auto row = flat.elements.begin() + flat.offsets[c];
+                row = copy(scratch.begin(), scratch.end(), row);
+                *row = 2 * formula.n_variables + c;
+            }
+        });
+
+    return flat;
+}
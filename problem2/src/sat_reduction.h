@@ -9,6 +9,23 @@ struct ThreeSATFormula {
     vector<vector<int>> clauses;
 };
 
+// CNF in CSR form: clause c is literals[offsets[c] .. offsets[c + 1]),
+// using the same signed 1-based literal encoding as ThreeSATFormula.
+struct FlatCnfFormula {
+    int n_variables;
+    int n_clauses;
+    vector<long long> offsets;
+    vector<int> literals;
+};
+
+ThreeSATFormula toThreeSATFormula(const FlatCnfFormula& flat);
+
 SetCoverInstance reduceThreeSATtoSetCover(const ThreeSATFormula& formula);
 
+// Same construction as reduceThreeSATtoSetCover, for clauses of any width,
+// written straight into CSR rows in parallel over clauses.
+// Both reductions throw invalid_argument when 2 * variables + clauses
+// exceeds INT_MAX.
+FlatSetCoverInstance reduceCnfToSetCover(const FlatCnfFormula& formula, int n_threads = 0);
+
 #endif
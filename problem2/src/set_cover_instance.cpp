@@ -0,0 +1,64 @@
+#include "set_cover_instance.h"
+
+SetCoverInstance toSetCoverInstance(const FlatSetCoverInstance& flat,
+                                    pmr::memory_resource* mem) {
+    SetCoverInstance instance(mem);
+    instance.n_elements = flat.n_elements;
+    instance.n_sets = flat.n_sets;
+    instance.sets.resize(flat.n_sets);
+
+    // Rows are sorted, so every insert lands at end() in amortized O(1).
+    vector<char> seen(flat.n_elements, 0);
+    for (int i = 0; i < flat.n_sets; i++) {
+        pmr::set<int>& s = instance.sets[i];
+        for (long long k = flat.offsets[i]; k < flat.offsets[i + 1]; k++) {
+            s.insert(s.end(), flat.elements[k]);
+            seen[flat.elements[k]] = 1;
+        }
+    }
+
+    for (int elem = 0; elem < flat.n_elements; elem++)
+        if (seen[elem]) instance.universe.insert(instance.universe.end(), elem);
+
+    instance.weights.assign(flat.weights.begin(), flat.weights.end());
+    return instance;
+}
+
+double totalWeight(const FlatSetCoverInstance& flat, const pmr::vector<int>& sets) {
+    if (!flat.weighted()) return sets.size();
+    double sum = 0;
+    for (int s : sets) sum += flat.weights[s];
+    return sum;
+}
+
+double totalWeight(const SetCoverInstance& inst, const pmr::vector<int>& sets) {
+    if (inst.weights.empty()) return sets.size();
+    double sum = 0;
+    for (int s : sets) sum += inst.weights[s];
+    return sum;
+}
+
+void checkWeights(const FlatSetCoverInstance& flat) {
+    if (!flat.weighted()) return;
+    if ((int)flat.weights.size() != flat.n_sets)
+        throw invalid_argument("weights must have one entry per set");
+    for (double w : flat.weights)
+        if (!(w >= 0) || !isfinite(w))
+            throw invalid_argument("set weights must be finite and non-negative");
+}
+
+void checkStructure(const FlatSetCoverInstance& flat) {
+    if (flat.n_elements < 0 || flat.n_sets < 0 || (int)flat.offsets.size() != flat.n_sets + 1 ||
+        flat.offsets[0] != 0 || flat.offsets[flat.n_sets] != (long long)flat.elements.size())
+        throw invalid_argument("bad set offsets");
+    for (int i = 0; i < flat.n_sets; i++) {
+        if (flat.offsets[i] > flat.offsets[i + 1]) throw invalid_argument("bad set offsets");
+        for (long long k = flat.offsets[i]; k < flat.offsets[i + 1]; k++) {
+            int elem = flat.elements[k];
+            if (elem < 0 || elem >= flat.n_elements)
+                throw invalid_argument("element out of range");
+            if (k > flat.offsets[i] && elem <= flat.elements[k - 1])
+                throw invalid_argument("set rows must be strictly ascending");
+        }
+    }
+}
@@ -2,21 +2,73 @@
 #define SET_COVER_INSTANCE_H
 
 #include <bits/stdc++.h>
+#include <memory_resource>
 using namespace std;
 
+// Containers draw their nodes from the memory resource given at construction
+// (the global heap by default), so a whole instance or solution can live in a
+// SetCoverArena and be dropped in one release().
 struct SetCoverInstance {
     int n_elements;
     int n_sets;
-    vector<set<int>> sets;
-    set<int> universe;
+    pmr::vector<pmr::set<int>> sets;
+    pmr::set<int> universe;
+    pmr::vector<double> weights;  // per-set cost; empty means every set costs 1
+
+    explicit SetCoverInstance(pmr::memory_resource* mem = pmr::get_default_resource())
+        : sets(mem), universe(mem), weights(mem) {}
+
+    SetCoverInstance(const SetCoverInstance& other,
+                     pmr::memory_resource* mem = pmr::get_default_resource())
+        : n_elements(other.n_elements), n_sets(other.n_sets),
+          sets(other.sets, mem), universe(other.universe, mem),
+          weights(other.weights, mem) {}
+
+    double weight(int i) const { return weights.empty() ? 1.0 : weights[i]; }
+
+    SetCoverInstance(SetCoverInstance&&) = default;
+    SetCoverInstance& operator=(const SetCoverInstance&) = default;
+    SetCoverInstance& operator=(SetCoverInstance&&) = default;
 };
 
 struct SetCoverSolution {
-    vector<int> selected_sets;
-    set<int> covered_elements;
-    int cost;
+    pmr::vector<int> selected_sets;
+    pmr::set<int> covered_elements;
+    int cost;               // number of selected sets
+    double total_weight;    // sum of their weights; equals cost when unweighted
     double approx_ratio;
     long long execution_time_us;
+
+    explicit SetCoverSolution(pmr::memory_resource* mem = pmr::get_default_resource())
+        : selected_sets(mem), covered_elements(mem) {}
+};
+
+// Compressed (CSR) layout used by the generators and reductions: set i owns
+// elements[offsets[i] .. offsets[i + 1]), stored in ascending order.
+struct FlatSetCoverInstance {
+    int n_elements;
+    int n_sets;
+    vector<long long> offsets;
+    vector<int> elements;
+    vector<double> weights;  // per-set cost; empty means every set costs 1
+
+    bool weighted() const { return !weights.empty(); }
+    double weight(int i) const { return weights.empty() ? 1.0 : weights[i]; }
 };
 
+SetCoverInstance toSetCoverInstance(const FlatSetCoverInstance& flat,
+                                    pmr::memory_resource* mem = pmr::get_default_resource());
+
+// Sum of the weights of `sets`.
+double totalWeight(const FlatSetCoverInstance& flat, const pmr::vector<int>& sets);
+double totalWeight(const SetCoverInstance& inst, const pmr::vector<int>& sets);
+
+// Throws invalid_argument unless weights are absent or one finite,
+// non-negative value per set.
+void checkWeights(const FlatSetCoverInstance& flat);
+
+// Throws invalid_argument unless offsets are monotone and every row holds
+// strictly ascending element ids in [0, n_elements).
+void checkStructure(const FlatSetCoverInstance& flat);
+
 #endif
@@ -1,43 +1,137 @@
 #include "set_cover_solver.h"
+#include "trace.h"
+#include "result_cache.h"
 
-SetCoverSolver::SetCoverSolver(const SetCoverInstance& inst)
-    : instance(inst) {}
+// Bump whenever solveGreedy could return a different cover.
+static const char* kGreedyVersion = "greedy-1";
+
+namespace {
+
+// Transpose of the CSR rows: element e lies in sets[offsets[e] .. offsets[e + 1]).
+struct ElementIndex {
+    vector<long long> offsets;
+    vector<int> sets;
+
+    explicit ElementIndex(const FlatSetCoverInstance& inst)
+        : offsets(inst.n_elements + 1, 0), sets(inst.elements.size()) {
+        for (int elem : inst.elements) offsets[elem + 1]++;
+        partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        vector<long long> next(offsets.begin(), offsets.end() - 1);
+        for (int i = 0; i < inst.n_sets; i++)
+            for (long long k = inst.offsets[i]; k < inst.offsets[i + 1]; k++)
+                sets[next[inst.elements[k]]++] = i;
+    }
+};
+
+// Elements covered per unit weight; free sets rank above everything.
+double effectiveness(int gain, double weight) {
+    return weight > 0 ? gain / weight : numeric_limits<double>::infinity();
+}
+
+}  // namespace
+
+SetCoverSolver::SetCoverSolver(const SetCoverInstance& inst,
+                               pmr::memory_resource* mem_in)
+    : mem(mem_in), instance(inst, mem_in) {}
+
+SetCoverSolver::SetCoverSolver(SetCoverInstance&& inst)
+    : mem(inst.sets.get_allocator().resource()), instance(move(inst)) {}
+
+string SetCoverSolver::canonicalBytes() const {
+    ByteWriter out;
+    out.put(instance.n_elements);
+    out.put(instance.n_sets);
+    out.putRange(instance.universe.begin(), instance.universe.end());
+    for (const auto& s : instance.sets)
+        out.putRange(s.begin(), s.end());
+    if (!instance.weights.empty())
+        out.putRange(instance.weights.begin(), instance.weights.end());
+    return out.str();
+}
 
 SetCoverSolution SetCoverSolver::solveGreedy() {
+    if (!cache) return runGreedy();
+
+    string key = ResultCache::makeKey("greedy", kGreedyVersion, canonicalBytes());
+    string payload;
+    if (cache->lookup(key, payload)) {
+        ByteReader in(payload);
+        SetCoverSolution solution(mem);
+        solution.execution_time_us = in.get<long long>();
+        long long count = in.get<long long>();
+        for (long long i = 0; i < count; i++) {
+            int s = in.get<int>();
+            solution.selected_sets.push_back(s);
+            solution.covered_elements.insert(instance.sets[s].begin(), instance.sets[s].end());
+        }
+        solution.cost = solution.selected_sets.size();
+        solution.total_weight = totalWeight(instance, solution.selected_sets);
+        return solution;
+    }
+
+    SetCoverSolution solution = runGreedy();
+    ByteWriter out;
+    out.put(solution.execution_time_us);
+    out.putRange(solution.selected_sets.begin(), solution.selected_sets.end());
+    cache->store(key, out.str());
+    return solution;
+}
+
+SetCoverSolution SetCoverSolver::runGreedy() {
     auto start = chrono::high_resolution_clock::now();
+    TraceProbe probe("greedy");
 
-    SetCoverSolution solution;
-    set<int> uncovered = instance.universe;
-    vector<bool> used(instance.n_sets, false);
+    // Scratch lives in a local arena: a few large blocks, dropped on return.
+    pmr::monotonic_buffer_resource scratch;
+    SetCoverSolution solution(mem);
+    pmr::set<int> uncovered(instance.universe, &scratch);
+    pmr::vector<bool> used(instance.n_sets, false, &scratch);
+    probe.phase("setup");
 
+    // Picks the set with the most uncovered elements per unit weight; with
+    // unit weights that is plain max coverage, lowest index on ties.
     while (!uncovered.empty()) {
         int best_set = -1, max_coverage = 0;
+        double best_weight = 1.0;
+        long long evaluated = 0, touched = 0;
 
         for (int i = 0; i < instance.n_sets; i++) {
             if (used[i]) continue;
+            evaluated++;
+            touched += instance.sets[i].size();
 
             int coverage = 0;
             for (int elem : instance.sets[i])
                 if (uncovered.count(elem)) coverage++;
 
-            if (coverage > max_coverage) {
+            double weight = instance.weight(i);
+            if (coverage > 0 && (best_set == -1 || coverage * best_weight > max_coverage * weight)) {
                 max_coverage = coverage;
+                best_weight = weight;
                 best_set = i;
             }
         }
 
+        probe.phase("scan");
         if (best_set == -1) break;
 
         used[best_set] = true;
         solution.selected_sets.push_back(best_set);
 
-        for (int elem : instance.sets[best_set]) {
+        for (int elem : instance.sets[best_set])
             uncovered.erase(elem);
+        probe.phase("update");
+
+        for (int elem : instance.sets[best_set])
             solution.covered_elements.insert(elem);
-        }
+        probe.phase("record");
+
+        probe.endIteration(best_set, max_coverage, evaluated,
+                           touched + 2 * instance.sets[best_set].size());
     }
 
     solution.cost = solution.selected_sets.size();
+    solution.total_weight = totalWeight(instance, solution.selected_sets);
     auto end = chrono::high_resolution_clock::now();
     solution.execution_time_us =
         chrono::duration_cast<chrono::microseconds>(end - start).count();
@@ -53,3 +147,251 @@ int SetCoverSolver::calculateLowerBound(const SetCoverInstance& inst) {
     if (max_set == 0) return inst.universe.size();
     return ceil((double)inst.universe.size() / max_set);
 }
+
+FlatSetCoverSolver::FlatSetCoverSolver(const FlatSetCoverInstance& inst,
+                                       pmr::memory_resource* mem_in)
+    : mem(mem_in), instance(inst) {}
+
+SetCoverSolution FlatSetCoverSolver::solveLazyGreedy() {
+    auto start = chrono::high_resolution_clock::now();
+    TraceProbe probe("lazy");
+    checkWeights(instance);
+
+    SetCoverSolution solution(mem);
+    vector<char> covered(instance.n_elements, 0);
+
+    // Entries are (gain per weight, -index) so equal keys pop lowest index
+    // first. Keys only shrink as elements get covered, so a stale key is
+    // still an upper bound.
+    priority_queue<pair<double, int>> heap;
+    for (int i = 0; i < instance.n_sets; i++) {
+        int size = instance.offsets[i + 1] - instance.offsets[i];
+        if (size > 0) heap.push({effectiveness(size, instance.weight(i)), -i});
+    }
+    probe.phase("setup");
+
+    long long evaluated = 0, touched = 0;
+    while (!heap.empty()) {
+        auto [bound, neg_index] = heap.top();
+        heap.pop();
+        int i = -neg_index;
+        evaluated++;
+        touched += instance.offsets[i + 1] - instance.offsets[i];
+
+        int gain = 0;
+        for (long long k = instance.offsets[i]; k < instance.offsets[i + 1]; k++)
+            if (!covered[instance.elements[k]]) gain++;
+
+        if (gain == 0) continue;
+        double current = effectiveness(gain, instance.weight(i));
+        if (current < bound) {
+            heap.push({current, neg_index});
+            continue;
+        }
+
+        probe.phase("scan");
+
+        for (long long k = instance.offsets[i]; k < instance.offsets[i + 1]; k++)
+            covered[instance.elements[k]] = 1;
+        probe.phase("update");
+
+        solution.selected_sets.push_back(i);
+        probe.phase("record");
+
+        long long size = instance.offsets[i + 1] - instance.offsets[i];
+        probe.endIteration(i, gain, evaluated, touched + size);
+        evaluated = touched = 0;
+    }
+    probe.phase("scan");
+
+    for (int elem = 0; elem < instance.n_elements; elem++)
+        if (covered[elem])
+            solution.covered_elements.insert(solution.covered_elements.end(), elem);
+    probe.phase("finalize");
+
+    solution.cost = solution.selected_sets.size();
+    solution.total_weight = totalWeight(instance, solution.selected_sets);
+    auto end = chrono::high_resolution_clock::now();
+    solution.execution_time_us =
+        chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    return solution;
+}
+
+SetCoverSolution FlatSetCoverSolver::solveWeightedGreedy() {
+    auto start = chrono::high_resolution_clock::now();
+    TraceProbe probe("weighted");
+    checkWeights(instance);
+
+    SetCoverSolution solution(mem);
+    ElementIndex index(instance);
+    vector<char> covered(instance.n_elements, 0);
+    vector<int> gain(instance.n_sets);
+
+    // Entries are (effectiveness, -index); a key is stale once the set's
+    // gain has dropped since it was pushed.
+    priority_queue<pair<double, int>> heap;
+    for (int i = 0; i < instance.n_sets; i++) {
+        gain[i] = instance.offsets[i + 1] - instance.offsets[i];
+        if (gain[i] > 0) heap.push({effectiveness(gain[i], instance.weight(i)), -i});
+    }
+    probe.phase("setup");
+
+    long long evaluated = 0, touched = 0;
+    while (!heap.empty()) {
+        auto [key, neg_index] = heap.top();
+        heap.pop();
+        int i = -neg_index;
+        evaluated++;
+
+        if (gain[i] == 0) continue;
+        double current = effectiveness(gain[i], instance.weight(i));
+        if (current < key) {
+            heap.push({current, neg_index});
+            continue;
+        }
+
+        probe.phase("scan");
+
+        int newly = gain[i];
+        for (long long k = instance.offsets[i]; k < instance.offsets[i + 1]; k++) {
+            int elem = instance.elements[k];
+            if (covered[elem]) continue;
+            covered[elem] = 1;
+            for (long long t = index.offsets[elem]; t < index.offsets[elem + 1]; t++)
+                gain[index.sets[t]]--;
+            touched += index.offsets[elem + 1] - index.offsets[elem];
+        }
+        probe.phase("update");
+
+        solution.selected_sets.push_back(i);
+        probe.phase("record");
+
+        long long size = instance.offsets[i + 1] - instance.offsets[i];
+        probe.endIteration(i, newly, evaluated, touched + size);
+        evaluated = touched = 0;
+    }
+    probe.phase("scan");
+
+    for (int elem = 0; elem < instance.n_elements; elem++)
+        if (covered[elem])
+            solution.covered_elements.insert(solution.covered_elements.end(), elem);
+    probe.phase("finalize");
+
+    solution.cost = solution.selected_sets.size();
+    solution.total_weight = totalWeight(instance, solution.selected_sets);
+    auto end = chrono::high_resolution_clock::now();
+    solution.execution_time_us =
+        chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    return solution;
+}
+
+SetCoverSolution FlatSetCoverSolver::solvePrimalDual() {
+    auto start = chrono::high_resolution_clock::now();
+    TraceProbe probe("primal-dual");
+    checkWeights(instance);
+
+    SetCoverSolution solution(mem);
+    ElementIndex index(instance);
+    vector<double> slack(instance.n_sets);
+    for (int i = 0; i < instance.n_sets; i++) slack[i] = instance.weight(i);
+    vector<char> covered(instance.n_elements, 0), taken(instance.n_sets, 0);
+    vector<int> order;
+    dual_bound = 0;
+    probe.phase("setup");
+
+    for (int elem = 0; elem < instance.n_elements; elem++) {
+        long long first = index.offsets[elem], last = index.offsets[elem + 1];
+        if (covered[elem] || first == last) continue;
+
+        double delta = numeric_limits<double>::infinity();
+        for (long long t = first; t < last; t++)
+            delta = min(delta, slack[index.sets[t]]);
+        dual_bound += delta;
+        probe.phase("scan");
+
+        // Relative tolerance so rounding in repeated subtraction cannot keep
+        // a set that should be tight from being taken.
+        int tight = 0;
+        for (long long t = first; t < last; t++) {
+            int s = index.sets[t];
+            slack[s] -= delta;
+            if (taken[s] || slack[s] > 1e-12 * max(1.0, instance.weight(s))) continue;
+
+            slack[s] = 0;
+            taken[s] = 1;
+            order.push_back(s);
+            tight++;
+            for (long long k = instance.offsets[s]; k < instance.offsets[s + 1]; k++)
+                covered[instance.elements[k]] = 1;
+        }
+        probe.phase("update");
+        probe.endIteration(order.back(), tight, last - first, 2 * (last - first));
+    }
+
+    // Reverse delete: a set is redundant if every one of its elements is
+    // also covered by another chosen set.
+    vector<int> times_covered(instance.n_elements, 0);
+    for (int s : order)
+        for (long long k = instance.offsets[s]; k < instance.offsets[s + 1]; k++)
+            times_covered[instance.elements[k]]++;
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int s = *it;
+        bool redundant = true;
+        for (long long k = instance.offsets[s]; k < instance.offsets[s + 1] && redundant; k++)
+            redundant = times_covered[instance.elements[k]] > 1;
+        if (!redundant) continue;
+
+        taken[s] = 0;
+        for (long long k = instance.offsets[s]; k < instance.offsets[s + 1]; k++)
+            times_covered[instance.elements[k]]--;
+    }
+    probe.phase("record");
+
+    for (int s : order)
+        if (taken[s]) solution.selected_sets.push_back(s);
+    for (int elem = 0; elem < instance.n_elements; elem++)
+        if (covered[elem])
+            solution.covered_elements.insert(solution.covered_elements.end(), elem);
+    probe.phase("finalize");
+
+    solution.cost = solution.selected_sets.size();
+    solution.total_weight = totalWeight(instance, solution.selected_sets);
+    auto end = chrono::high_resolution_clock::now();
+    solution.execution_time_us =
+        chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    return solution;
+}
+
+int FlatSetCoverSolver::calculateLowerBound(const FlatSetCoverInstance& inst) {
+    vector<char> seen(inst.n_elements, 0);
+    long long max_set = 0;
+    for (int i = 0; i < inst.n_sets; i++) {
+        max_set = max(max_set, inst.offsets[i + 1] - inst.offsets[i]);
+        for (long long k = inst.offsets[i]; k < inst.offsets[i + 1]; k++)
+            seen[inst.elements[k]] = 1;
+    }
+
+    long long universe = count(seen.begin(), seen.end(), 1);
+    if (max_set == 0) return universe;
+    return ceil((double)universe / max_set);
+}
+
+double FlatSetCoverSolver::calculateWeightedLowerBound(const FlatSetCoverInstance& inst) {
+    vector<double> price(inst.n_elements, numeric_limits<double>::infinity());
+    for (int i = 0; i < inst.n_sets; i++) {
+        long long size = inst.offsets[i + 1] - inst.offsets[i];
+        if (size == 0) continue;
+        double per_element = inst.weight(i) / size;
+        for (long long k = inst.offsets[i]; k < inst.offsets[i + 1]; k++)
+            price[inst.elements[k]] = min(price[inst.elements[k]], per_element);
+    }
+
+    double bound = 0;
+    for (double p : price)
+        if (p != numeric_limits<double>::infinity()) bound += p;
+    return bound;
+}
@@ -3,16 +3,80 @@
 
 #include "set_cover_instance.h"
 
+class ResultCache;
+
+// Solvers keep their instance copy, scratch state and returned solutions in
+// `mem`, which defaults to the global heap.
 class SetCoverSolver {
 private:
+    pmr::memory_resource* mem;
     SetCoverInstance instance;
+    ResultCache* cache = nullptr;
+
+    SetCoverSolution runGreedy();
 
 public:
-    SetCoverSolver(const SetCoverInstance& inst);
+    SetCoverSolver(const SetCoverInstance& inst,
+                   pmr::memory_resource* mem_in = pmr::get_default_resource());
+
+    // Adopts the instance and the memory resource it was built on.
+    SetCoverSolver(SetCoverInstance&& inst);
+
+    // solveGreedy() looks results up in and stores them to `cache_in` (may
+    // be null). A hit reports the execution time of the original solve.
+    void setResultCache(ResultCache* cache_in) { cache = cache_in; }
+
+    // Sizes, universe and every set's elements in order.
+    string canonicalBytes() const;
 
     SetCoverSolution solveGreedy();
 
     static int calculateLowerBound(const SetCoverInstance& inst);
 };
 
+// Greedy over the CSR layout. Gains per unit weight are kept in a max-heap as
+// upper bounds and only re-evaluated (by rescanning the set) when a set
+// reaches the top, so each selection touches few sets. Ties go to the lowest
+// index, so like SetCoverSolver::solveGreedy it picks by coverage per weight,
+// plain coverage on unweighted instances. The instance must outlive the
+// solver.
+//
+// Every solver honours FlatSetCoverInstance::weights (unit weights when
+// absent). The weighted greedy and primal-dual run in O(sum |S| log m): both
+// keep an element -> sets index so covering an element touches only the sets
+// that contain it.
+class FlatSetCoverSolver {
+private:
+    pmr::memory_resource* mem;
+    const FlatSetCoverInstance& instance;
+    double dual_bound = 0;
+
+public:
+    FlatSetCoverSolver(const FlatSetCoverInstance& inst,
+                       pmr::memory_resource* mem_in = pmr::get_default_resource());
+
+    SetCoverSolution solveLazyGreedy();
+
+    // H(max |S|)-approximation: repeatedly takes the set with the lowest
+    // weight per newly covered element. Gains are maintained exactly and the
+    // heap is repaired lazily; with unit weights it returns the same cover as
+    // solveLazyGreedy.
+    SetCoverSolution solveWeightedGreedy();
+
+    // f-approximation, f = the largest number of sets sharing an element.
+    // Raises each uncovered element's dual until a set containing it becomes
+    // tight, takes every tight set, then drops redundant sets in reverse order.
+    SetCoverSolution solvePrimalDual();
+
+    // Dual objective of the last solvePrimalDual(): a lower bound on the
+    // optimal cover weight.
+    double dualBound() const { return dual_bound; }
+
+    static int calculateLowerBound(const FlatSetCoverInstance& inst);
+
+    // LP lower bound on the optimal weight: every element is charged the
+    // cheapest per-element price min w(S)/|S| over the sets containing it.
+    static double calculateWeightedLowerBound(const FlatSetCoverInstance& inst);
+};
+
 #endif
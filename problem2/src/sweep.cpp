@@ -0,0 +1,213 @@
+#include "sweep.h"
+#include "engines.h"
+#include "arena.h"
+#include "parallel.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+struct SweepJob {
+    int n_elements;
+    int n_sets;
+    double set_ratio;
+    double density;
+    uint64_t seed;
+    size_t first_result;  // results for this instance start here, one per engine
+    double estimated_cost;
+};
+
+// Pins the calling thread to the slot-th CPU it is allowed to run on, so
+// timings are not disturbed by migrations.
+void pinCurrentThread(int slot) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+
+    int n_allowed = CPU_COUNT(&allowed);
+    if (n_allowed == 0) return;
+
+    int target = slot % n_allowed;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        if (target-- == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(cpu, &one);
+            pthread_setaffinity_np(pthread_self(), sizeof(one), &one);
+            return;
+        }
+    }
+#else
+    (void)slot;
+#endif
+}
+
+double quantile(const vector<double>& sorted, double q) {
+    double pos = q * (sorted.size() - 1);
+    size_t lo = (size_t)floor(pos), hi = min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// All tree storage for the cell (instance copies, solutions) is carved from
+// the worker's arena, which the caller releases once the cell is done.
+void runJob(const SweepJob& job, const SweepGrid& grid, SetCoverArena& arena,
+            vector<SweepResult>& results) {
+    GeneratorOptions options;
+    options.distribution = grid.distribution;
+    options.weights = grid.weights;
+    options.n_threads = 1;  // the sweep already keeps every core busy
+
+    FlatSetCoverInstance flat =
+        generateFlatSetCover(job.n_elements, job.n_sets, job.density, job.seed, options);
+    double lower_bound = flat.weighted() ? FlatSetCoverSolver::calculateWeightedLowerBound(flat)
+                                         : FlatSetCoverSolver::calculateLowerBound(flat);
+
+    // Single-threaded engines: a pinned worker owns one core.
+    EngineOptions engine_opts;
+    engine_opts.n_threads = 1;
+    engine_opts.time_budget_ms = grid.time_budget_ms;
+
+    for (size_t e = 0; e < grid.engines.size(); e++) {
+        auto engine = makeSetCoverEngine(grid.engines[e], flat, arena.resource(), engine_opts);
+        SweepResult& r = results[job.first_result + e];
+
+        if (grid.trace) {
+            ostringstream label;
+            label << "n=" << job.n_elements << " m=" << job.n_sets
+                  << " d=" << job.density << " seed=" << job.seed;
+            r.trace.label = label.str();
+            ScopedTrace scope(r.trace);
+            engine->solve();
+        }
+
+        vector<double> samples;
+        int cost = 0;
+        double weight = 0;
+        for (int rep = 0; rep < max(1, grid.repetitions); rep++) {
+            auto start = chrono::steady_clock::now();
+            SetCoverSolution solution = engine->solve();
+            auto end = chrono::steady_clock::now();
+            cost = solution.cost;
+            weight = solution.total_weight;
+            samples.push_back(chrono::duration<double, micro>(end - start).count());
+        }
+        sort(samples.begin(), samples.end());
+
+        r.n_elements = job.n_elements;
+        r.n_sets = job.n_sets;
+        r.set_ratio = job.set_ratio;
+        r.density = job.density;
+        r.seed = job.seed;
+        r.engine = grid.engines[e];
+        r.repetitions = samples.size();
+        r.median_us = quantile(samples, 0.5);
+        r.q1_us = quantile(samples, 0.25);
+        r.q3_us = quantile(samples, 0.75);
+        r.min_us = samples.front();
+        r.max_us = samples.back();
+        r.cost = cost;
+        r.weight = weight;
+        r.lower_bound = lower_bound;
+        r.approx_ratio = lower_bound > 0 ? weight / lower_bound : 0.0;
+    }
+}
+
+}  // namespace
+
+vector<SweepResult> runSweep(const SweepGrid& grid) {
+    for (const string& name : grid.engines)
+        if (find(setCoverEngineNames().begin(), setCoverEngineNames().end(), name) ==
+            setCoverEngineNames().end())
+            throw invalid_argument("unknown set cover engine: " + name);
+
+    vector<SweepJob> jobs;
+    for (int n : grid.sizes)
+        for (double ratio : grid.set_ratios)
+            for (double density : grid.densities)
+                for (uint64_t seed : grid.seeds) {
+                    int m = max(1, (int)(ratio * n));
+                    jobs.push_back({n, m, ratio, density, seed,
+                                    jobs.size() * grid.engines.size(),
+                                    (double)n * m * max(density, 1.0 / max(1, n))});
+                }
+
+    vector<SweepResult> results(jobs.size() * grid.engines.size());
+
+    // Longest-first: the biggest instances start immediately instead of
+    // becoming a straggler tail at the end of the sweep.
+    vector<size_t> order(jobs.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return jobs[a].estimated_cost > jobs[b].estimated_cost;
+    });
+
+    int n_workers = (int)min<size_t>(resolveThreadCount(grid.n_threads), max<size_t>(1, jobs.size()));
+    atomic<size_t> next(0);
+    auto worker = [&](int slot) {
+        if (grid.pin_threads) pinCurrentThread(slot);
+        SetCoverArena arena;
+        for (size_t k; (k = next.fetch_add(1)) < order.size();) {
+            runJob(jobs[order[k]], grid, arena, results);
+            arena.release();
+        }
+    };
+
+    // Every worker gets its own thread, so pinning never narrows the
+    // caller's affinity (or that of threads it starts later).
+    vector<thread> pool;
+    for (int w = 0; w < n_workers; w++) pool.emplace_back(worker, w);
+    for (auto& th : pool) th.join();
+
+    return results;
+}
+
+void writeSweepCsv(const string& path, const vector<SweepResult>& results) {
+    ofstream out(path);
+    if (!out) throw runtime_error("cannot write " + path);
+    writeSweepCsv(out, results);
+}
+
+void writeSweepCsv(ostream& out, const vector<SweepResult>& results) {
+    out << "Problem_Size,Num_Sets,Set_Ratio,Density,Seed,Engine,Repetitions,"
+           "Time_us_Median,Time_us_Q1,Time_us_Q3,Time_us_IQR,Time_us_Min,Time_us_Max,"
+           "Solution_Cost,Solution_Weight,Lower_Bound,Approx_Ratio\n";
+    out << fixed << setprecision(3);
+    for (const auto& r : results)
+        out << r.n_elements << "," << r.n_sets << "," << r.set_ratio << ","
+            << r.density << "," << r.seed << "," << r.engine << ","
+            << r.repetitions << "," << r.median_us << "," << r.q1_us << ","
+            << r.q3_us << "," << r.q3_us - r.q1_us << "," << r.min_us << ","
+            << r.max_us << "," << r.cost << "," << r.weight << "," << r.lower_bound << ","
+            << r.approx_ratio << "\n";
+}
+
+void writeSweepJson(const string& path, const vector<SweepResult>& results) {
+    ofstream out(path);
+    if (!out) throw runtime_error("cannot write " + path);
+
+    out << "[\n" << fixed << setprecision(3);
+    for (size_t k = 0; k < results.size(); k++) {
+        const auto& r = results[k];
+        out << "  {\"problem_size\": " << r.n_elements
+            << ", \"num_sets\": " << r.n_sets
+            << ", \"set_ratio\": " << r.set_ratio
+            << ", \"density\": " << r.density
+            << ", \"seed\": " << r.seed
+            << ", \"engine\": \"" << r.engine << "\""
+            << ", \"repetitions\": " << r.repetitions
+            << ", \"time_us\": {\"median\": " << r.median_us
+            << ", \"q1\": " << r.q1_us << ", \"q3\": " << r.q3_us
+            << ", \"iqr\": " << r.q3_us - r.q1_us
+            << ", \"min\": " << r.min_us << ", \"max\": " << r.max_us << "}"
+            << ", \"solution_cost\": " << r.cost
+            << ", \"solution_weight\": " << r.weight
+            << ", \"lower_bound\": " << r.lower_bound
+            << ", \"approx_ratio\": " << r.approx_ratio << "}"
+            << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
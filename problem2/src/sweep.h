@@ -0,0 +1,52 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "generators.h"
+#include "trace.h"
+
+// Cartesian grid of experiment parameters. Every (size, ratio, density, seed)
+// combination is one instance; every engine is timed on it.
+struct SweepGrid {
+    vector<int> sizes = {10, 20, 50, 100, 200, 500};
+    vector<double> set_ratios = {1.5};
+    vector<double> densities = {0.4};
+    vector<uint64_t> seeds = {42};
+    vector<string> engines = {"greedy", "lazy"};
+    SetDistribution distribution = SetDistribution::Uniform;
+    SetWeights weights = SetWeights::Unit;
+    int repetitions = 5;
+    int n_threads = 0;        // 0 = all hardware threads
+    bool pin_threads = true;  // pin each worker to its own CPU (Linux only)
+    bool trace = false;       // record one extra, untimed solve per cell
+    double time_budget_ms = 0;  // per-solve portfolio budget, 0 = none
+};
+
+struct SweepResult {
+    int n_elements;
+    int n_sets;
+    double set_ratio;
+    double density;
+    uint64_t seed;
+    string engine;
+    int repetitions;
+    double median_us;
+    double q1_us;
+    double q3_us;
+    double min_us;
+    double max_us;
+    int cost;                 // sets in the cover
+    double weight;            // their total weight (= cost when unweighted)
+    double lower_bound;       // on the optimal cardinality, or weight if weighted
+    double approx_ratio;      // weight / lower_bound
+    SolverTrace trace;        // empty unless grid.trace in a TRACE=1 build
+};
+
+// Runs every cell of the grid. Instances are scheduled largest first across
+// the worker pool; results come back in grid order regardless of scheduling.
+vector<SweepResult> runSweep(const SweepGrid& grid);
+
+void writeSweepCsv(const string& path, const vector<SweepResult>& results);
+void writeSweepCsv(ostream& out, const vector<SweepResult>& results);
+void writeSweepJson(const string& path, const vector<SweepResult>& results);
+
+#endif
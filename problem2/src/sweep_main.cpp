@@ -0,0 +1,101 @@
+#include <bits/stdc++.h>
+#include "sweep.h"
+using namespace std;
+
+// Usage: setcover_sweep [--sizes 10,20,...] [--ratios 1.5,...]
+//        [--densities 0.4,...] [--seeds 42,...] [--engines greedy,lazy]
+//        [--distribution uniform|zipf|clustered] [--weights unit|uniform|scaled]
+//        [--reps 5] [--threads 0] [--budget ms]
+//        [--no-pin] [--csv file] [--json file] [--trace prefix]
+//
+// The CSV goes to stdout unless --csv is given.
+// --trace needs a TRACE=1 build and writes <prefix>.csv and <prefix>.json
+// (Chrome trace events) with per-iteration phase timings for every cell.
+
+template <class T>
+vector<T> parseList(const string& text) {
+    vector<T> values;
+    stringstream ss(text);
+    for (string item; getline(ss, item, ',');) {
+        stringstream conv(item);
+        T value;
+        if (!(conv >> value)) throw invalid_argument("bad list value: " + item);
+        values.push_back(value);
+    }
+    return values;
+}
+
+SetDistribution parseDistribution(const string& name) {
+    if (name == "uniform") return SetDistribution::Uniform;
+    if (name == "zipf") return SetDistribution::Zipf;
+    if (name == "clustered") return SetDistribution::Clustered;
+    throw invalid_argument("unknown distribution: " + name);
+}
+
+SetWeights parseWeights(const string& name) {
+    if (name == "unit") return SetWeights::Unit;
+    if (name == "uniform") return SetWeights::Uniform;
+    if (name == "scaled") return SetWeights::SizeScaled;
+    throw invalid_argument("unknown weight model: " + name);
+}
+
+int main(int argc, char** argv) {
+    SweepGrid grid;
+    string csv_path, json_path, trace_prefix;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string flag = argv[i];
+            if (flag == "--no-pin") {
+                grid.pin_threads = false;
+                continue;
+            }
+            if (i + 1 >= argc) throw invalid_argument("missing value for " + flag);
+            string value = argv[++i];
+
+            if (flag == "--sizes") grid.sizes = parseList<int>(value);
+            else if (flag == "--ratios") grid.set_ratios = parseList<double>(value);
+            else if (flag == "--densities") grid.densities = parseList<double>(value);
+            else if (flag == "--seeds") grid.seeds = parseList<uint64_t>(value);
+            else if (flag == "--engines") grid.engines = parseList<string>(value);
+            else if (flag == "--distribution") grid.distribution = parseDistribution(value);
+            else if (flag == "--weights") grid.weights = parseWeights(value);
+            else if (flag == "--reps") grid.repetitions = stoi(value);
+            else if (flag == "--threads") grid.n_threads = stoi(value);
+            else if (flag == "--budget") grid.time_budget_ms = stod(value);
+            else if (flag == "--csv") csv_path = value;
+            else if (flag == "--json") json_path = value;
+            else if (flag == "--trace") trace_prefix = value;
+            else throw invalid_argument("unknown flag " + flag);
+        }
+
+        if (!trace_prefix.empty()) {
+            if (!kTraceCompiledIn)
+                throw invalid_argument("--trace needs a build with TRACE=1 (make -B TRACE=1)");
+            grid.trace = true;
+        }
+
+        auto start = chrono::steady_clock::now();
+        vector<SweepResult> results = runSweep(grid);
+        auto end = chrono::steady_clock::now();
+
+        if (csv_path.empty()) writeSweepCsv(cout, results);
+        else writeSweepCsv(csv_path, results);
+        if (!json_path.empty()) writeSweepJson(json_path, results);
+        if (grid.trace) {
+            vector<SolverTrace> traces;
+            for (auto& r : results) traces.push_back(move(r.trace));
+            writeTraceCsv(trace_prefix + ".csv", traces);
+            writeChromeTrace(trace_prefix + ".json", traces);
+        }
+
+        cerr << results.size() << " cells in " << fixed << setprecision(2)
+             << chrono::duration<double>(end - start).count() << " s -> "
+             << (csv_path.empty() ? "stdout" : csv_path) << "\n";
+    } catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
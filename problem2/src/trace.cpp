@@ -0,0 +1,90 @@
+#include "trace.h"
+
+namespace {
+
+thread_local SolverTrace* current_trace = nullptr;
+
+string jsonEscape(const string& text) {
+    string out;
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+}  // namespace
+
+ScopedTrace::ScopedTrace(SolverTrace& trace) : previous(current_trace) {
+    current_trace = &trace;
+}
+
+ScopedTrace::~ScopedTrace() {
+    current_trace = previous;
+}
+
+SolverTrace* activeTrace() {
+    return current_trace;
+}
+
+void writeTraceCsv(const string& path, const vector<SolverTrace>& traces) {
+    ofstream out(path);
+    if (!out) throw runtime_error("cannot write " + path);
+
+    out << "Label,Engine,Iteration,Phase,Start_us,Duration_us,Selected_Set,"
+           "Marginal_Gain,Sets_Evaluated,Elements_Touched\n";
+    out << fixed << setprecision(3);
+    for (const auto& trace : traces) {
+        for (const auto& p : trace.phases) {
+            out << "\"" << trace.label << "\"," << trace.engine << ","
+                << p.iteration << "," << p.name << "," << p.start_ns / 1000.0
+                << "," << p.duration_ns / 1000.0 << ",";
+
+            if (p.iteration >= 1 && p.iteration <= (int)trace.iterations.size()) {
+                const auto& it = trace.iterations[p.iteration - 1];
+                out << it.selected_set << "," << it.marginal_gain << ","
+                    << it.sets_evaluated << "," << it.elements_touched << "\n";
+            } else {
+                out << "-1,0,0,0\n";
+            }
+        }
+    }
+}
+
+void writeChromeTrace(const string& path, const vector<SolverTrace>& traces) {
+    ofstream out(path);
+    if (!out) throw runtime_error("cannot write " + path);
+
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    out << fixed << setprecision(3);
+    bool first = true;
+    auto separator = [&]() -> const char* {
+        const char* sep = first ? "  " : ",\n  ";
+        first = false;
+        return sep;
+    };
+
+    for (size_t tid = 0; tid < traces.size(); tid++) {
+        const auto& trace = traces[tid];
+        out << separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+            << tid << ", \"args\": {\"name\": \"" << jsonEscape(trace.label + " " + trace.engine)
+            << "\"}}";
+
+        for (const auto& p : trace.phases) {
+            out << separator() << "{\"name\": \"" << p.name << "\", \"cat\": \""
+                << jsonEscape(trace.engine) << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid
+                << ", \"ts\": " << p.start_ns / 1000.0 << ", \"dur\": " << p.duration_ns / 1000.0
+                << ", \"args\": {\"iteration\": " << p.iteration;
+
+            if (p.iteration >= 1 && p.iteration <= (int)trace.iterations.size()) {
+                const auto& it = trace.iterations[p.iteration - 1];
+                out << ", \"selected_set\": " << it.selected_set
+                    << ", \"marginal_gain\": " << it.marginal_gain
+                    << ", \"sets_evaluated\": " << it.sets_evaluated
+                    << ", \"elements_touched\": " << it.elements_touched;
+            }
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+}
@@ -0,0 +1,123 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <bits/stdc++.h>
+using namespace std;
+
+// Per-iteration instrumentation for the set cover engines. Probes only
+// record when built with -DSETCOVER_TRACE (make TRACE=1); otherwise every
+// probe call is an empty inline function and the counters feeding it are
+// dead code.
+
+#ifdef SETCOVER_TRACE
+constexpr bool kTraceCompiledIn = true;
+#else
+constexpr bool kTraceCompiledIn = false;
+#endif
+
+struct TracePhase {
+    const char* name;  // setup, scan, update, record, finalize
+    int iteration;     // 1-based; 0 for setup/finalize
+    long long start_ns;
+    long long duration_ns;
+};
+
+struct TraceIteration {
+    int selected_set;
+    long long marginal_gain;
+    long long sets_evaluated;
+    long long elements_touched;
+};
+
+struct SolverTrace {
+    string label;
+    string engine;
+    vector<TracePhase> phases;
+    vector<TraceIteration> iterations;
+};
+
+// Makes `trace` the calling thread's sink until the scope ends. Solves on
+// this thread append to it; other threads are unaffected.
+class ScopedTrace {
+public:
+    explicit ScopedTrace(SolverTrace& trace);
+    ~ScopedTrace();
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    SolverTrace* previous;
+};
+
+SolverTrace* activeTrace();
+
+#ifdef SETCOVER_TRACE
+class TraceProbe {
+public:
+    explicit TraceProbe(const char* engine)
+        : sink(activeTrace()), origin(now()), mark(origin) {
+        if (sink && sink->engine.empty()) sink->engine = engine;
+    }
+
+    // Closes the phase that began at the previous phase boundary.
+    void phase(const char* name) {
+        if (!sink) return;
+        long long t = now();
+        int iteration = strcmp(name, "setup") == 0 || strcmp(name, "finalize") == 0
+            ? 0 : (int)sink->iterations.size() + 1;
+        sink->phases.push_back({name, iteration, mark - origin, t - mark});
+        mark = t;
+    }
+
+    void endIteration(int selected_set, long long gain, long long sets_evaluated,
+                      long long elements_touched) {
+        if (sink) sink->iterations.push_back({selected_set, gain, sets_evaluated, elements_touched});
+    }
+
+    long long originNs() const { return origin; }
+
+    // Appends a trace recorded by another probe (e.g. one run on a worker
+    // thread) whose origin was other_origin_ns: its iterations follow ours
+    // and its phases move onto our clock. The next phase starts afterwards.
+    void absorb(const SolverTrace& other, long long other_origin_ns) {
+        if (!sink) return;
+        int base = sink->iterations.size();
+        for (TracePhase p : other.phases) {
+            if (p.iteration > 0) p.iteration += base;
+            p.start_ns += other_origin_ns - origin;
+            sink->phases.push_back(p);
+        }
+        sink->iterations.insert(sink->iterations.end(), other.iterations.begin(),
+                                other.iterations.end());
+        mark = now();
+    }
+
+private:
+    static long long now() {
+        return chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    SolverTrace* sink;
+    long long origin, mark;
+};
+#else
+class TraceProbe {
+public:
+    explicit TraceProbe(const char*) {}
+    void phase(const char*) {}
+    void endIteration(int, long long, long long, long long) {}
+    long long originNs() const { return 0; }
+    void absorb(const SolverTrace&, long long) {}
+};
+#endif
+
+// One row per phase: Label,Engine,Iteration,Phase,Start_us,Duration_us,
+// Selected_Set,Marginal_Gain,Sets_Evaluated,Elements_Touched.
+void writeTraceCsv(const string& path, const vector<SolverTrace>& traces);
+
+// Chrome trace-event JSON (chrome://tracing, Perfetto): one track per trace.
+void writeChromeTrace(const string& path, const vector<SolverTrace>& traces);
+
+#endif